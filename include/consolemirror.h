@@ -0,0 +1,71 @@
+#ifndef CONSOLEMIRROR_H
+#define CONSOLEMIRROR_H
+
+#include <QByteArray>
+#include <QString>
+#include <QtGlobal>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "mpscqueue.h"
+
+// Copia de los mensajes del launcher en stdout (debug/info) y stderr (el
+// resto). El hilo que registra sólo encola; un hilo propio agrupa las
+// líneas en un buffer reutilizado y las escribe con write(). Los avisos y
+// errores se vuelcan en cuanto llegan, la depuración cada kFlushIntervalMs.
+class ConsoleMirror
+{
+public:
+    // Cualquier hilo; sólo bloquea con QtFatalMsg, que se escribe antes de
+    // volver porque Qt aborta justo después: primero espera (como mucho
+    // kFatalFlushTimeoutMs) a que salgan las líneas encoladas, para que el
+    // fatal no aparezca antes que los mensajes que lo preceden. Tras
+    // destruir la instancia (salida del programa) escribe directamente.
+    static void print(QtMsgType type, const QString &msg);
+
+    ConsoleMirror(const ConsoleMirror &) = delete;
+    ConsoleMirror &operator=(const ConsoleMirror &) = delete;
+
+    static constexpr int kFlushIntervalMs = 100;
+    static constexpr int kFatalFlushTimeoutMs = 2000;
+
+private:
+    struct Line {
+        int fd = 1;
+        QByteArray text; // con el salto de línea
+    };
+
+    static ConsoleMirror &instance();
+
+    ConsoleMirror();
+    ~ConsoleMirror();
+
+    void write(int fd, QByteArray text, bool urgent);
+    // Espera (como mucho timeoutMs) a que lo encolado hasta ahora esté
+    // escrito, como LogFileWriter::flush
+    bool flush(int timeoutMs);
+
+    void run();
+    void flushQueue();
+    static void writeAll(int fd, const QByteArray &data);
+
+    MpscQueue<Line> m_queue;
+    std::mutex m_mutex; // m_wake, m_stop, m_flush*
+    std::condition_variable m_cv;
+    std::condition_variable m_flushedCv;
+    bool m_wake = false;
+    bool m_stop = false;
+    quint64 m_flushRequested = 0;
+    quint64 m_flushed = 0;
+
+    // Sólo el hilo de escritura
+    QByteArray m_buffer;
+    int m_bufferFd = 1;
+
+    std::thread m_thread;
+};
+
+#endif // CONSOLEMIRROR_H
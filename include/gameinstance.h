@@ -0,0 +1,138 @@
+#ifndef GAMEINSTANCE_H
+#define GAMEINSTANCE_H
+
+#include <QObject>
+#include <QProcess>
+#include <QString>
+
+#include "launchmetrics.h"
+#include "minecraftlaunch.h"
+
+class GameLog;
+class ProcessTelemetry;
+class QTimer;
+
+// Un proceso del cliente lanzado por el launcher: su versión, perfil, PID,
+// estado, telemetría y salida. Se encarga también de la parada escalonada
+// (SIGTERM y, pasado el margen, SIGKILL).
+class GameInstance : public QObject {
+  Q_OBJECT
+  Q_PROPERTY(int instanceId READ instanceId CONSTANT)
+  Q_PROPERTY(QString version READ versionName CONSTANT)
+  Q_PROPERTY(QString versionPath READ versionPath CONSTANT)
+  Q_PROPERTY(QString profile READ profile CONSTANT)
+  Q_PROPERTY(qint64 pid READ pid NOTIFY statusChanged)
+  Q_PROPERTY(QString status READ status NOTIFY statusChanged)
+  Q_PROPERTY(QString stopPhase READ stopPhase NOTIFY statusChanged)
+  Q_PROPERTY(qint64 startedAt READ startedAt NOTIFY statusChanged)
+  Q_PROPERTY(QString exitKind READ exitKind NOTIFY statusChanged)
+  Q_PROPERTY(int exitCode READ exitCode NOTIFY statusChanged)
+  Q_PROPERTY(int exitSignal READ exitSignal NOTIFY statusChanged)
+  Q_PROPERTY(qint64 uptimeMs READ uptimeMs NOTIFY statusChanged)
+  Q_PROPERTY(QString crashReport READ crashReport NOTIFY statusChanged)
+  Q_PROPERTY(QObject *telemetry READ telemetry CONSTANT)
+  Q_PROPERTY(QObject *gameLog READ gameLog CONSTANT)
+
+public:
+  GameInstance(int id, const QString &versionName, const QString &versionPath,
+               const QString &profile, QObject *parent = nullptr);
+
+  // Arranca el cliente sin bloquear. metrics registra las fases del
+  // arranque; scheduling se aplica al proceso en cuanto arranca.
+  void start(const LaunchSpec &spec,
+             const ProcessPriority::Settings &scheduling,
+             const QString &logsDir, LaunchMetrics *metrics);
+
+  // SIGTERM y, si sigue vivo tras stopGraceMs, SIGKILL. Llamarla de nuevo
+  // durante la espera (o antes de que el proceso arranque) mata directamente.
+  Q_INVOKABLE void stop();
+  Q_INVOKABLE void kill();
+
+  int instanceId() const { return m_id; }
+  QString versionName() const { return m_versionName; }
+  QString versionPath() const { return m_versionPath; }
+  QString profile() const { return m_profile; }
+  // Directorio de datos del cliente (MinecraftLaunch::dataDir)
+  QString dataDir() const { return m_dataDir; }
+  void setDataDir(const QString &dir) { m_dataDir = dir; }
+  qint64 pid() const { return m_pid; }
+  // "launching", "running", "stopping", "exited", "crashed" o "failed"
+  QString status() const { return m_status; }
+  // "terminating", "killing" o vacío
+  QString stopPhase() const { return m_stopPhase; }
+  qint64 startedAt() const { return m_startedAt; }
+  // Clasificación de la salida: "clean" (código 0), "stopped" (parada
+  // pedida desde el launcher), "error" (código distinto de 0) o "signal"
+  // (terminado por una señal, directamente o a través de un envoltorio que
+  // sale con 128 + señal). Vacío mientras el proceso vive.
+  QString exitKind() const { return m_exitKind; }
+  int exitCode() const { return m_exitCode; }
+  int exitSignal() const { return m_exitSignal; }
+  // Tiempo entre QProcess::started y la salida (o hasta ahora)
+  qint64 uptimeMs() const;
+  bool hasCrashed() const {
+    return m_exitKind == QLatin1String("error") ||
+           m_exitKind == QLatin1String("signal");
+  }
+  // Informe escrito en logsDir al fallar (vacío si no hubo fallo)
+  QString crashReport() const { return m_crashReport; }
+  // Descripción legible del motivo de salida
+  QString exitReason() const;
+
+  bool isLaunching() const { return m_status == QLatin1String("launching"); }
+  // Lanzando, en marcha o parándose
+  bool isLive() const;
+
+  QObject *telemetry() const;
+  QObject *gameLog() const;
+  GameLog *log() const { return m_gameLog; }
+
+  int stopGraceMs() const { return m_stopGraceMs; }
+  void setStopGraceMs(int ms) { m_stopGraceMs = qMax(0, ms); }
+
+  // Salida que se copia al informe de fallo
+  static constexpr int kCrashTailBytes = 64 * 1024;
+
+signals:
+  void statusChanged();
+  void started();
+  void launchFailed(const QString &reason);
+  // killed: hubo que escalar a SIGKILL
+  void finished(int exitCode, QProcess::ExitStatus exitStatus, bool killed);
+  // Salida anómala (exitKind "error" o "signal"); se emite antes de finished
+  void crashed(const QString &reason, const QString &reportPath);
+
+private:
+  void setStatus(const QString &status);
+  void escalateStop();
+  void readOutput(bool isStderr);
+  void classifyExit(int code, QProcess::ExitStatus status);
+  QString writeCrashReport() const;
+
+  int m_id = 0;
+  QString m_versionName;
+  QString m_versionPath;
+  QString m_profile;
+  QString m_dataDir;
+  qint64 m_pid = 0;
+  qint64 m_startedAt = 0;
+  qint64 m_finishedAt = 0;
+  QString m_logsDir;
+  bool m_stopRequested = false;
+  QString m_exitKind;
+  int m_exitCode = 0;
+  int m_exitSignal = 0;
+  QString m_crashReport;
+  QString m_status;
+  QString m_stopPhase;
+  int m_stopGraceMs = 3000;
+
+  QProcess *m_process = nullptr;
+  QTimer *m_stopTimer = nullptr;
+  ProcessTelemetry *m_telemetry = nullptr;
+  GameLog *m_gameLog = nullptr;
+  LaunchMetrics *m_metrics = nullptr;
+  LaunchMetrics::Session m_session;
+};
+
+#endif // GAMEINSTANCE_H
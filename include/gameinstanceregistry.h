@@ -0,0 +1,77 @@
+#ifndef GAMEINSTANCEREGISTRY_H
+#define GAMEINSTANCEREGISTRY_H
+
+#include <QAbstractListModel>
+#include <QList>
+#include <QStringList>
+#include <QVariantMap>
+
+class GameInstance;
+
+// Instancias del cliente lanzadas en esta sesión del launcher, una fila por
+// instancia (las más nuevas al final). Las que ya terminaron se conservan
+// (hasta kKeepFinished) para poder consultar su salida y telemetría.
+class GameInstanceRegistry : public QAbstractListModel {
+  Q_OBJECT
+  Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+  Q_PROPERTY(int liveCount READ liveCount NOTIFY instancesChanged)
+  // versión -> estado ("launching", "running", "terminating", "killing")
+  // de las instancias vivas, para enlazar desde QML sin recorrer el modelo
+  Q_PROPERTY(QVariantMap versionStates READ versionStates NOTIFY
+                 instancesChanged)
+
+public:
+  enum InstanceRoles {
+    IdRole = Qt::UserRole + 1,
+    VersionRole,
+    ProfileRole,
+    PidRole,
+    StatusRole,
+    StopPhaseRole,
+    StartedAtRole,
+    InstanceRole
+  };
+
+  explicit GameInstanceRegistry(QObject *parent = nullptr);
+
+  int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex &index,
+                int role = Qt::DisplayRole) const override;
+  QHash<int, QByteArray> roleNames() const override;
+
+  // Toma posesión de la instancia y la añade al final
+  void add(GameInstance *instance);
+  int nextId() { return ++m_lastId; }
+
+  GameInstance *find(int instanceId) const;
+  // Instancia viva de una versión, o nullptr
+  GameInstance *liveForVersion(const QString &versionName) const;
+  // Instancia viva que usa ese directorio de datos, o nullptr
+  GameInstance *liveForDataDir(const QString &dataDir) const;
+  QList<GameInstance *> liveInstances() const;
+  int liveCount() const;
+  QVariantMap versionStates() const;
+
+  Q_INVOKABLE QObject *instance(int instanceId) const;
+  Q_INVOKABLE void stop(int instanceId);
+  Q_INVOKABLE void kill(int instanceId);
+  Q_INVOKABLE void stopAll();
+  // Elimina del modelo las instancias que ya terminaron
+  Q_INVOKABLE void clearFinished();
+
+  static constexpr int kKeepFinished = 8;
+
+signals:
+  void countChanged();
+  // Alguna instancia se añadió, cambió de estado o se eliminó
+  void instancesChanged();
+
+private:
+  void pruneFinished();
+  int rowOf(const GameInstance *instance) const;
+
+  QList<GameInstance *> m_instances;
+  int m_lastId = 0;
+};
+
+#endif // GAMEINSTANCEREGISTRY_H
@@ -0,0 +1,103 @@
+#ifndef GAMELOG_H
+#define GAMELOG_H
+
+#include <QAbstractListModel>
+#include <QFile>
+#include <QVector>
+
+class QTimer;
+
+// Salida (stdout/stderr) de la sesión de juego actual. Las líneas se guardan
+// en un buffer circular acotado que se expone como modelo de lista y se
+// replican en <logsDir>/game-<versión>-<fecha>.log, que rota por tamaño.
+class GameLog : public QAbstractListModel {
+  Q_OBJECT
+  Q_PROPERTY(bool active READ isActive NOTIFY sessionChanged)
+  Q_PROPERTY(QString sessionFile READ sessionFile NOTIFY sessionChanged)
+  Q_PROPERTY(int maxLines READ maxLines WRITE setMaxLines NOTIFY
+                 maxLinesChanged)
+  Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+
+public:
+  enum GameLogRoles { TimeRole = Qt::UserRole + 1, MessageRole, StderrRole };
+
+  struct Line {
+    qint64 timestamp = 0; // ms desde epoch
+    QString text;
+    bool isStderr = false;
+    // "hh:mm:ss" para TimeRole; las líneas del mismo segundo comparten la
+    // cadena
+    QString time;
+  };
+
+  explicit GameLog(QObject *parent = nullptr);
+  ~GameLog() override;
+
+  int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex &index,
+                int role = Qt::DisplayRole) const override;
+  QHash<int, QByteArray> roleNames() const override;
+
+  // Abre una sesión nueva (vacía el buffer y crea el archivo en logsDir)
+  void beginSession(const QString &versionName, const QString &logsDir);
+  // Añade un bloque leído del proceso; las líneas incompletas esperan al
+  // siguiente bloque del mismo canal
+  void appendData(const QByteArray &chunk, bool isStderr);
+  // Vuelca las líneas pendientes y cierra el archivo de la sesión
+  void endSession();
+
+  Q_INVOKABLE void clear();
+  Q_INVOKABLE QString getLogs() const;
+  // Últimas líneas del buffer que caben en maxBytes (UTF-8), en orden
+  QByteArray tail(int maxBytes) const;
+  Q_INVOKABLE void copyToClipboard() const;
+  Q_INVOKABLE void saveLog(const QString &filePath) const;
+
+  bool isActive() const { return m_file.isOpen(); }
+  QString sessionFile() const { return m_file.fileName(); }
+  int maxLines() const { return m_maxLines; }
+  void setMaxLines(int maxLines);
+
+  // Tamaño a partir del cual el archivo de sesión rota a .1, .2, ...
+  static constexpr qint64 kMaxFileBytes = 8 * 1024 * 1024;
+  static constexpr int kMaxRotations = 3;
+  // Número de sesiones (archivos game-*.log) que se conservan en logsDir
+  static constexpr int kKeepSessions = 20;
+  // La salida se acumula y se escribe al archivo como mucho cada
+  // kFlushIntervalMs, o antes si el bloque supera kFlushBytes
+  static constexpr int kFlushIntervalMs = 250;
+  static constexpr int kFlushBytes = 256 * 1024;
+
+signals:
+  void sessionChanged();
+  void maxLinesChanged();
+  void countChanged();
+
+private:
+  void appendLines(const QVector<Line> &lines);
+  void writeToFile(const QVector<Line> &lines);
+  void flushFile();
+  void rotateFile();
+  const Line &at(int row) const;
+  // Hora de una línea nueva, formateada una sola vez por segundo
+  QString timeFor(qint64 timestamp);
+  static QString formatLine(const Line &line);
+  static void pruneSessions(const QString &logsDir);
+
+  // Buffer circular: m_head apunta a la línea más antigua
+  QVector<Line> m_lines;
+  int m_head = 0;
+  int m_count = 0;
+  int m_maxLines = 5000;
+
+  qint64 m_timeSecond = -1;
+  QString m_time;
+
+  QByteArray m_pendingOut;
+  QByteArray m_pendingErr;
+  QFile m_file;
+  QByteArray m_fileBuffer; // pendiente de escribir en m_file
+  QTimer *m_flushTimer = nullptr;
+};
+
+#endif // GAMELOG_H
@@ -0,0 +1,81 @@
+#ifndef LAUNCHMETRICS_H
+#define LAUNCHMETRICS_H
+
+#include <QByteArrayList>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QObject>
+#include <QVariantList>
+
+// Tiempos de arranque por versión. Cada lanzamiento mide, desde la petición
+// (runGame), cuándo arranca el proceso, cuándo llega la primera línea de
+// stdout y cuándo el cliente informa de que ha creado la ventana. Las
+// últimas kMaxSamples medidas de cada fase se guardan por versión en
+// <launcherDir>/launch_metrics.json para comparar p50/p95 entre versiones.
+class LaunchMetrics : public QObject {
+  Q_OBJECT
+  Q_PROPERTY(QVariantList summary READ summary NOTIFY summaryChanged)
+  Q_PROPERTY(QString windowMarker READ windowMarker WRITE setWindowMarker
+                 NOTIFY windowMarkerChanged)
+
+public:
+  explicit LaunchMetrics(QObject *parent = nullptr);
+
+  // Archivo de persistencia; se carga al asignarlo
+  void setStorePath(const QString &path);
+
+  // Medidas de un lanzamiento. Cada instancia de juego lleva la suya, así
+  // que varias sesiones simultáneas no se mezclan.
+  struct Session {
+    QString version;
+    QElapsedTimer clock;
+    qint64 startedMs = -1;
+    qint64 firstOutputMs = -1;
+    qint64 windowMs = -1;
+    // Bytes de stdout ya buscados; al pasar kMaxScanBytes o kMaxScanMs sin
+    // ver la ventana se deja de buscar y la fase cuenta como no vista
+    qint64 scannedBytes = 0;
+    bool windowMissing = false;
+  };
+
+  // Fases de un lanzamiento; las marcas repetidas se ignoran
+  Session begin(const QString &versionName) const;
+  void markStarted(Session &session) const;
+  // Sólo stdout: stderr no cuenta para la primera línea ni para la ventana
+  void observeOutput(Session &session, const QByteArray &chunk) const;
+  // Cierra la sesión: guarda las fases medidas (una sesión que falló antes
+  // de arrancar no aporta muestras)
+  void finish(Session &session);
+
+  // Una entrada por versión: version, launches, windowMissing (arranques en
+  // los que no se vio la ventana) y <fase>P50/<fase>P95 en ms (started,
+  // firstOutput, window; -1 si no hay muestras)
+  QVariantList summary() const;
+  Q_INVOKABLE void reset(const QString &versionName = QString());
+
+  // Textos alternativos separados por "|" (sin distinguir mayúsculas ASCII)
+  // que identifican en stdout la creación de la ventana. Se buscan sobre los
+  // bytes tal cual, sin decodificar cada bloque. No hay un evento del
+  // sistema de ventanas accesible desde aquí, así que es una aproximación.
+  QString windowMarker() const;
+  void setWindowMarker(const QString &pattern);
+
+  static constexpr int kMaxSamples = 100;
+  static constexpr qint64 kMaxScanMs = 120 * 1000;
+  static constexpr qint64 kMaxScanBytes = 4 * 1024 * 1024;
+
+signals:
+  void summaryChanged();
+  void windowMarkerChanged();
+
+private:
+  void record(const QString &version, const QString &phase, qint64 ms);
+  void load();
+  void save() const;
+
+  QString m_storePath;
+  QJsonObject m_versions;
+  QByteArrayList m_windowMarkers; // en minúsculas
+};
+
+#endif // LAUNCHMETRICS_H
@@ -0,0 +1,32 @@
+#ifndef LOGCATEGORIES_H
+#define LOGCATEGORIES_H
+
+#include <QList>
+#include <QLoggingCategory>
+#include <QString>
+
+// Categorías de log por subsistema. Los mensajes de depuración vienen
+// desactivados: qCDebug sobre una categoría apagada sólo cuesta comprobar
+// un flag, sin formatear nada. Se activan en caliente desde la consola.
+Q_DECLARE_LOGGING_CATEGORY(lcPaths)    // launcher.paths
+Q_DECLARE_LOGGING_CATEGORY(lcVersions) // launcher.versions
+Q_DECLARE_LOGGING_CATEGORY(lcInstall)  // launcher.install
+Q_DECLARE_LOGGING_CATEGORY(lcGame)     // launcher.game
+Q_DECLARE_LOGGING_CATEGORY(lcWorlds)   // launcher.worlds
+Q_DECLARE_LOGGING_CATEGORY(lcProfiles) // launcher.profiles
+Q_DECLARE_LOGGING_CATEGORY(lcUi)       // launcher.ui
+
+namespace LogCategories {
+
+QList<QLoggingCategory *> all();
+QLoggingCategory *find(const QString &name);
+
+// Activa o desactiva los mensajes de depuración de una categoría y guarda
+// la elección para el siguiente arranque
+bool setDebugEnabled(const QString &name, bool enabled);
+// Aplica las categorías guardadas (llamar al arrancar)
+void restore();
+
+} // namespace LogCategories
+
+#endif // LOGCATEGORIES_H
@@ -0,0 +1,85 @@
+#ifndef LOGEXPORTER_H
+#define LOGEXPORTER_H
+
+#include <QFuture>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include "loghandler.h"
+
+class LogFileWriter;
+
+// Exporta el log a un archivo desde un hilo de trabajo. Las líneas se
+// formatean y se escriben por bloques directamente en el destino (con gzip
+// si se pide), sin construir nunca el texto completo en memoria. El
+// destino se escribe con QSaveFile: un fallo o una cancelación no dejan un
+// archivo a medias.
+class LogExporter : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool busy READ isBusy NOTIFY busyChanged)
+    Q_PROPERTY(double progress READ progress NOTIFY progressChanged)
+
+public:
+    struct Job {
+        QString path;
+        bool gzip = false;
+        // Contenido de la consola; las cadenas se comparten, no se copian
+        QVector<LogMessage> messages;
+        // Historial en disco (launcher-*.log[.gz]) en orden cronológico; si
+        // no está vacío sustituye a messages, que ya están en esos archivos
+        QStringList files;
+        // Se vacía antes de leer files para incluir lo último registrado
+        LogFileWriter *writer = nullptr;
+    };
+
+    explicit LogExporter(QObject *parent = nullptr);
+    // Cancela la exportación en curso y espera a que el hilo termine
+    ~LogExporter() override;
+
+    // false si ya hay una exportación en marcha
+    bool start(Job job);
+    Q_INVOKABLE void cancel();
+
+    bool isBusy() const { return m_busy; }
+    double progress() const { return m_progress; }
+
+    // Logs del launcher en dir, del más antiguo al más reciente. Si un
+    // archivo aparece también comprimido (compresión en curso) se usa el
+    // original.
+    static QStringList historyFiles(const QString &dir);
+
+    static constexpr int kChunkBytes = 256 * 1024;
+    static constexpr int kFlushTimeoutMs = 2000;
+
+signals:
+    void busyChanged();
+    void progressChanged();
+    // Con ok, error no vacío lista los archivos del historial que ya no
+    // estaban al leerlos
+    void finished(const QString &path, bool ok, const QString &error);
+
+private:
+    struct Result {
+        bool ok = false;
+        bool cancelled = false;
+        QString error;
+    };
+
+    void setProgress(double progress);
+    static Result run(const Job &job, const std::function<void(double)> &progressFn,
+                      const std::shared_ptr<std::atomic_bool> &cancelled);
+
+    bool m_busy = false;
+    double m_progress = 0.0;
+    std::shared_ptr<std::atomic_bool> m_cancel;
+    QFuture<Result> m_future;
+};
+
+#endif // LOGEXPORTER_H
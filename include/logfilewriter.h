@@ -0,0 +1,94 @@
+#ifndef LOGFILEWRITER_H
+#define LOGFILEWRITER_H
+
+#include <QFile>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "mpscqueue.h"
+
+// Copia persistente del log del launcher en <dir>/launcher-YYYYMMDD.log.
+// Los mensajes se encolan sin bloquear y un hilo propio los formatea y
+// escribe por lotes, así que el manejador de mensajes nunca espera al
+// disco. El archivo cambia cada día y rota al superar maxFileBytes; los
+// archivos cerrados se comprimen (.gz) y se borran pasados keepDays.
+class LogFileWriter
+{
+public:
+    struct Entry {
+        qint64 timestamp = 0; // ms desde epoch
+        QtMsgType type = QtDebugMsg;
+        QString message;
+    };
+
+    LogFileWriter();
+    ~LogFileWriter();
+    LogFileWriter(const LogFileWriter &) = delete;
+    LogFileWriter &operator=(const LogFileWriter &) = delete;
+
+    // Cualquier hilo; nunca bloquea, salvo con QtFatalMsg: el proceso aborta
+    // al volver del manejador, así que espera (como mucho
+    // kFatalFlushTimeoutMs) a que el mensaje esté en disco
+    void append(qint64 timestamp, QtMsgType type, const QString &message);
+
+    // Mientras no haya directorio los mensajes se retienen en memoria
+    // (hasta kMaxHeldLines) y se escriben en cuanto se configure
+    void setDirectory(const QString &dir);
+    // Comprimir (.gz) los archivos cerrados al cambiar de día o rotar
+    void setCompressRotated(bool compress) { m_compress.store(compress); }
+    bool compressRotated() const { return m_compress.load(); }
+    // Archivo abierto ahora mismo (vacío si aún no hay directorio)
+    QString currentFile() const;
+    QString directory() const;
+    // Espera (como mucho timeoutMs) a que lo encolado hasta ahora esté en
+    // disco. Para hilos de trabajo; desde el manejador de mensajes sólo la
+    // usa append() con QtFatalMsg.
+    bool flush(int timeoutMs);
+
+    static constexpr qint64 kMaxFileBytes = 10 * 1024 * 1024;
+    static constexpr int kKeepDays = 14;
+    static constexpr int kMaxHeldLines = 10000;
+    // Lote a partir del cual se despierta al hilo antes del intervalo
+    static constexpr int kWakeBatch = 256;
+    static constexpr int kFlushIntervalMs = 500;
+    static constexpr int kFatalFlushTimeoutMs = 2000;
+
+private:
+    void run();
+    void writeBatch(QVector<Entry> &batch);
+    void openFor(qint64 timestamp);
+    void rotateBySize();
+    void finishFile(const QString &path);
+    void pruneOld();
+    static bool gzipFile(const QString &path);
+
+    MpscQueue<Entry> m_queue;
+    std::atomic<int> m_pending{0};
+    std::atomic_bool m_compress{true};
+
+    mutable std::mutex m_mutex; // m_wake, m_stop, m_dir, m_currentPath, m_flush*
+    std::condition_variable m_cv;
+    std::condition_variable m_flushedCv;
+    bool m_wake = false;
+    bool m_stop = false;
+    quint64 m_flushRequested = 0;
+    quint64 m_flushed = 0;
+    QString m_dir;
+    QString m_currentPath;
+
+    // Sólo el hilo escritor
+    QFile m_file;
+    qint64 m_fileDay = -1; // días desde epoch (hora local) del archivo abierto
+    QString m_openDir;
+    QVector<Entry> m_held;
+
+    std::thread m_thread;
+};
+
+#endif // LOGFILEWRITER_H
@@ -0,0 +1,103 @@
+#ifndef LOGFILTERMODEL_H
+#define LOGFILTERMODEL_H
+
+#include <QAbstractListModel>
+#include <QRegularExpression>
+#include <QString>
+
+#include <deque>
+
+class LogHandler;
+struct LogMessage;
+class QTimer;
+
+// Vista filtrada de la consola del launcher: nivel mínimo, componente
+// ("[MinecraftManager]"), texto o expresión regular y rango de tiempo.
+//
+// Guarda la secuencia (LogHandler::firstSeq() + fila) de cada línea que
+// pasa el filtro. Las líneas nuevas se evalúan al llegar y las descartadas
+// se quitan por delante, así que el filtro no se recalcula aunque el buffer
+// crezca. Al cambiar el filtro, los índices de LogHandler por componente y
+// por nivel dan las candidatas y sólo a ellas se les aplica el texto.
+class LogFilterModel : public QAbstractListModel
+{
+    Q_OBJECT
+    // 0 debug, 1 info, 2 warning, 3 critical/fatal
+    Q_PROPERTY(int minLevel READ minLevel WRITE setMinLevel NOTIFY filterChanged)
+    // Vacío = todos
+    Q_PROPERTY(QString component READ component WRITE setComponent NOTIFY filterChanged)
+    // Se aplica kTextDebounceMs después del último cambio
+    Q_PROPERTY(QString text READ text WRITE setText NOTIFY filterChanged)
+    Q_PROPERTY(bool useRegex READ useRegex WRITE setUseRegex NOTIFY filterChanged)
+    Q_PROPERTY(bool regexValid READ regexValid NOTIFY filterChanged)
+    // ms desde epoch; 0 = sin límite
+    Q_PROPERTY(qint64 since READ since WRITE setSince NOTIFY filterChanged)
+    Q_PROPERTY(qint64 until READ until WRITE setUntil NOTIFY filterChanged)
+    // Ventana móvil: sólo las líneas de los últimos window ms (0 = sin
+    // límite). Las que se salen de ella desaparecen solas.
+    Q_PROPERTY(qint64 window READ window WRITE setWindow NOTIFY filterChanged)
+    Q_PROPERTY(bool active READ isActive NOTIFY filterChanged)
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    explicit LogFilterModel(LogHandler *source, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    int minLevel() const { return m_minLevel; }
+    void setMinLevel(int level);
+    QString component() const { return m_component; }
+    void setComponent(const QString &component);
+    QString text() const { return m_text; }
+    void setText(const QString &text);
+    bool useRegex() const { return m_useRegex; }
+    void setUseRegex(bool useRegex);
+    bool regexValid() const { return !m_useRegex || m_regex.isValid(); }
+    qint64 since() const { return m_since; }
+    void setSince(qint64 since);
+    qint64 until() const { return m_until; }
+    void setUntil(qint64 until);
+    qint64 window() const { return m_window; }
+    void setWindow(qint64 window);
+
+    bool isActive() const;
+    int count() const { return int(m_rows.size()); }
+
+    Q_INVOKABLE void reset();
+
+    static constexpr int kTextDebounceMs = 250;
+    // Cada cuánto se quitan las líneas que salen de la ventana móvil
+    static constexpr int kWindowTickMs = 1000;
+
+signals:
+    void filterChanged();
+    void countChanged();
+
+private:
+    void refilter();
+    void rebuild();
+    bool accepts(const LogMessage &msg, qint64 cutoff) const;
+    qint64 windowCutoff() const;
+    void sourceRowsInserted(const QModelIndex &parent, int first, int last);
+    void sourceRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last);
+    void expireWindow();
+
+    LogHandler *m_source = nullptr;
+    // Secuencias de las filas visibles, en orden
+    std::deque<qint64> m_rows;
+    QTimer *m_textTimer = nullptr;
+    QTimer *m_windowTimer = nullptr;
+
+    int m_minLevel = 0;
+    QString m_component;
+    QString m_text;
+    bool m_useRegex = false;
+    QRegularExpression m_regex;
+    qint64 m_since = 0;
+    qint64 m_until = 0;
+    qint64 m_window = 0;
+};
+
+#endif // LOGFILTERMODEL_H
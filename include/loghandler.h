@@ -5,31 +5,70 @@
 #include <QObject>
 #include <QString>
 #include <QList>
-#include <QDateTime>
 #include <QMutex>
+#include <QHash>
+#include <QSet>
+#include <QStringList>
+#include <QVariantList>
+#include <QVector>
 #include <QtGlobal>
 
+#include <atomic>
+#include <deque>
+#include <memory>
+
+#include "mpscqueue.h"
+
+class LogExporter;
+class LogFileWriter;
+
+class QTimer;
+
+// Nivel en orden de gravedad (QtMsgType no lo está)
+enum class LogLevel : quint8 { Debug, Info, Warning, Critical, Fatal };
+
+// Registro compacto: el texto de nivel, el color y la hora visible se
+// derivan al mostrarlo; component comparte los datos del pool de LogHandler
 struct LogMessage {
-    QDateTime timestamp;
-    QtMsgType type;
+    qint64 timestamp = 0; // ms desde epoch
+    LogLevel level = LogLevel::Debug;
     QString message;
-    QString color;
+    // Prefijo "[Componente]" del mensaje, extraído al registrarlo
+    QString component;
 };
 
 class LogHandler : public QAbstractListModel
 {
     Q_OBJECT
+    // Memoria que puede ocupar la consola; al superarla se descartan las
+    // líneas más antiguas. Se guarda en la configuración.
+    Q_PROPERTY(int memoryBudgetMb READ memoryBudgetMb WRITE setMemoryBudgetMb NOTIFY memoryBudgetChanged)
+    // Comprimir los archivos de log cerrados (día anterior o rotados). Se
+    // guarda en la configuración.
+    Q_PROPERTY(bool compressRotatedLogs READ compressRotatedLogs WRITE setCompressRotatedLogs NOTIFY compressRotatedLogsChanged)
+    // Bytes que ocupan ahora los registros (estimación por registro)
+    Q_PROPERTY(qint64 memoryUsage READ memoryUsage NOTIFY countChanged)
+    Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+    // Componentes vistos hasta ahora, para el filtro de la consola
+    Q_PROPERTY(QStringList components READ components NOTIFY componentsChanged)
+    // Categorías del launcher (launcher.*) y si su depuración está activa:
+    // [{ name, debug }]
+    Q_PROPERTY(QVariantList logCategories READ logCategories NOTIFY logCategoriesChanged)
+    // Exportación en curso (busy, progress, finished)
+    Q_PROPERTY(QObject *exporter READ exporter CONSTANT)
 
 public:
     enum LogRoles {
         TimeRole = Qt::UserRole + 1,
         TypeRole,
         MessageRole,
-        ColorRole
+        ColorRole,
+        ComponentRole,
+        TimestampMsRole
     };
 
     explicit LogHandler(QObject *parent = nullptr);
-    ~LogHandler() Q_DECL_NOEXCEPT override = default;
+    ~LogHandler() Q_DECL_NOEXCEPT override;
     static LogHandler* instance();
 
     int rowCount(const QModelIndex &parent = QModelIndex()) const override;
@@ -37,26 +76,118 @@ public:
     QHash<int, QByteArray> roleNames() const override;
 
     Q_INVOKABLE void clear();
+    // Exporta la consola en segundo plano (comprimida si termina en .gz)
     Q_INVOKABLE void saveLog(const QString &filePath);
+    // Exportación en segundo plano. includeHistory: todos los logs del
+    // launcher guardados en disco en lugar de sólo la consola. false si ya
+    // hay una exportación en marcha.
+    Q_INVOKABLE bool exportLog(const QString &filePath, bool gzip, bool includeHistory);
     Q_INVOKABLE void copyToClipboard();
     Q_INVOKABLE QString getLogs();
+    // Archivo de log persistente de hoy (vacío si aún no hay directorio)
+    Q_INVOKABLE QString logFile() const;
+
+    // Directorio de los logs persistentes (PathManager::logsDir). Lo
+    // registrado antes de configurarlo se escribe en cuanto se conoce.
+    void setLogDirectory(const QString &dir);
+
+    QObject *exporter() const;
 
     static void messageOutput(QtMsgType type, const QMessageLogContext &context, const QString &msg);
 
+    // Al reducirlo se conservan las líneas más recientes que quepan
+    int memoryBudgetMb() const { return int(m_memoryBudget / (1024 * 1024)); }
+    void setMemoryBudgetMb(int mb);
+    qint64 memoryUsage() const { return m_memoryUsage; }
+    bool compressRotatedLogs() const;
+    void setCompressRotatedLogs(bool compress);
+    // Memoria atribuida a un registro: la estructura y el texto del mensaje
+    // (el componente es compartido y no cuenta)
+    static qint64 recordBytes(const LogMessage &msg);
+
+    QStringList components() const { return m_componentList; }
+    QVariantList logCategories() const;
+    Q_INVOKABLE bool setCategoryDebug(const QString &name, bool enabled);
+    // Acceso directo para LogFilterModel (fila del modelo)
+    const LogMessage &messageAt(int row) const { return at(row); }
+    // Índices para LogFilterModel. Cada registro tiene un número de
+    // secuencia que no cambia al descartar los anteriores: la fila 0 es
+    // firstSeq() y la fila r, firstSeq() + r. Las listas están en orden
+    // ascendente; rowsForComponent devuelve nullptr si el componente no está
+    // en el pool (entonces no está indexado).
+    qint64 firstSeq() const { return m_firstSeq; }
+    const std::deque<qint64> &rowsForLevel(LogLevel level) const
+    {
+        return m_levelRows[static_cast<int>(level)];
+    }
+    const std::deque<qint64> *rowsForComponent(const QString &component) const;
+    // "[Componente] texto" -> "Componente" (también con el prefijo "qml: ")
+    static QString parseComponent(const QString &msg);
+    static LogLevel levelFor(QtMsgType type);
+    // Cadenas compartidas (no se copian por mensaje)
+    static const QString &levelName(LogLevel level);
+    static const QString &levelColor(LogLevel level);
+
+    // Intervalo con el que el hilo de la GUI vacía la cola de mensajes
+    static constexpr int kDrainIntervalMs = 50;
+    static constexpr int kMaxComponents = 200;
+    // Segundos distintos que se guardan ya formateados
+    static constexpr int kTimeCacheSize = 1024;
+    static constexpr int kDefaultBudgetMb = 16;
+    static constexpr int kMinBudgetMb = 1;
+    static constexpr int kMaxBudgetMb = 1024;
+    static constexpr int kInitialCapacity = 1024;
+    static constexpr int kLevelCount = static_cast<int>(LogLevel::Fatal) + 1;
+
+signals:
+    void memoryBudgetChanged();
+    void compressRotatedLogsChanged();
+    void countChanged();
+    void componentsChanged();
+    void logCategoriesChanged();
+
 private:
     void appendMessage(QtMsgType type, const QString &msg);
-
-private slots:
-    void appendMessageOnMainThread(int type, const QString &msg,
-                                   const QString &color,
-                                   const QDateTime &timestamp);
+    void drainQueue();
+    void appendBatch(const QVector<LogMessage> &batch);
+    const LogMessage &at(int row) const;
+    LogMessage &slot(int row) { return m_messages[(m_head + row) % m_messages.size()]; }
+    // Descarta las filas más antiguas hasta que usage + incoming quepa en
+    // el presupuesto (siempre queda sitio para lo que llega)
+    void evictFor(qint64 incoming);
+    // Amplía el buffer para que quepan count filas, reordenándolo desde 0
+    void reserveRows(int count);
+    // "yyyy-MM-dd HH:mm:ss" de un instante, formateado una vez por segundo
+    const QString &timeString(qint64 timestamp) const;
 
 private:
+    // Los mensajes llegan desde cualquier hilo a la cola sin bloqueos; el
+    // primero de cada lote programa el vaciado en el hilo de la GUI, que los
+    // inserta en el modelo con una sola notificación
+    MpscQueue<LogMessage> m_queue;
+    std::atomic_bool m_drainScheduled{false};
+    QTimer *m_drainTimer = nullptr;
+    std::unique_ptr<LogFileWriter> m_fileWriter;
+    LogExporter *m_exporter = nullptr;
 
-    QList<LogMessage> m_messages;
+    // Buffer circular que crece según haga falta: lo que se conserva lo
+    // decide el presupuesto de memoria, no el número de líneas. La fila 0
+    // es m_messages[m_head].
+    QVector<LogMessage> m_messages;
+    int m_head = 0;
+    int m_count = 0;
+    qint64 m_memoryBudget = qint64(kDefaultBudgetMb) * 1024 * 1024;
+    qint64 m_memoryUsage = 0;
+    QSet<QString> m_componentSet; // pool: los mensajes comparten estas cadenas
+    QStringList m_componentList;
+    // Secuencias de las filas de cada nivel y de cada componente del pool;
+    // crecen al insertar y se recortan por delante al descartar
+    qint64 m_firstSeq = 0;
+    std::deque<qint64> m_levelRows[kLevelCount];
+    QHash<QString, std::deque<qint64>> m_componentRows;
+    mutable QHash<qint64, QString> m_timeCache;
     static LogHandler* m_instance;
     QMutex m_mutex;
-    const int m_maxLines = 2000;
 };
 
 #endif // LOGHANDLER_H
@@ -1,11 +1,64 @@
 #ifndef MINECRAFTLAUNCH_H
 #define MINECRAFTLAUNCH_H
 
+#include <QJsonObject>
 #include <QObject>
+#include <QProcessEnvironment>
 #include <QString>
 #include <QStringList>
+#include <QVariantMap>
+
+#include "processpriority.h"
 
 class PathManager;
+class QProcess;
+
+// Opciones de arranque de una versión. Se guardan en
+// <versión>/launch_preset.json y las aplican todas las rutas que ejecutan el
+// cliente (jugar e importar).
+struct LaunchPreset
+{
+    // "default", "nvidia" (PRIME render offload), "prime" (DRI_PRIME para
+    // Mesa) o "zink"
+    QString gpu = QStringLiteral("default");
+    bool mangohud = false;
+    bool gamemode = false;
+    // Ejecutar con setsid para separar el cliente de la sesión del launcher
+    bool detach = true;
+    // "version": datos en <profilesDir>/<versión>; "shared": directorio por
+    // defecto del cliente, compartido entre versiones
+    QString profileMode = QStringLiteral("version");
+    // Variables de entorno y argumentos extra para el cliente
+    QVariantMap env;
+    QStringList extraArgs;
+    // Planificación del cliente tras arrancar: CPUs permitidas (vacío =
+    // todas), nice (0 = sin cambio) y clase/nivel de E/S ("none",
+    // "best-effort", "idle", "realtime"; nivel 0-7)
+    QList<int> cpus;
+    int nice = 0;
+    QString ioClass = QStringLiteral("none");
+    int ioLevel = 4;
+    // Caché de shaders propia de la versión (ver MinecraftLaunch::
+    // shaderCacheDir) en lugar de la compartida de Mesa/NVIDIA, y su tamaño
+    // máximo en MB
+    bool shaderCache = true;
+    int shaderCacheMaxMb = 1024;
+
+    ProcessPriority::Settings scheduling() const;
+
+    static LaunchPreset fromJson(const QJsonObject &obj);
+    QJsonObject toJson() const;
+};
+
+// Invocación concreta resultante de un preset
+struct LaunchSpec
+{
+    QString program;
+    QStringList arguments;
+    QProcessEnvironment environment;
+
+    bool isValid() const { return !program.isEmpty(); }
+};
 
 class MinecraftLaunch : public QObject
 {
@@ -13,22 +66,39 @@ class MinecraftLaunch : public QObject
 public:
     explicit MinecraftLaunch(PathManager *paths = nullptr, QObject *parent = nullptr);
 
-    // Ejecuta el cliente para una versión específica.
-    // Devuelve true si el proceso se lanzó correctamente.
-    bool runGame(const QString &versionPath,
-                 bool useNvidia = false,
-                 bool useZink = false,
-                 bool useShared = false,
-                 bool useMangohud = false);
+    // Preset de una versión (ruta completa); los valores por defecto si no
+    // hay archivo o no se puede leer
+    LaunchPreset loadPreset(const QString &versionPath) const;
+    bool savePreset(const QString &versionPath, const LaunchPreset &preset) const;
+
+    // Construye programa, argumentos y entorno para ejecutar el cliente con
+    // una versión. clientArgs se añade tras los argumentos de datos/perfil
+    // (por ejemplo -ifp <archivo>). Devuelve un spec inválido si el cliente
+    // no está configurado.
+    LaunchSpec buildSpec(const QString &versionPath, const LaunchPreset &preset,
+                         const QStringList &clientArgs = QStringList()) const;
+    static void start(QProcess *proc, const LaunchSpec &spec);
+    // Directorio de datos que usará el cliente con este preset:
+    // <profilesDir>/<versión> (se le pasa con -dd) o, con profileMode
+    // "shared", su directorio por defecto. Vacío sólo si no hay PathManager.
+    QString dataDir(const QString &versionPath, const LaunchPreset &preset) const;
+    // Directorio de mcpelauncher-client cuando no recibe -dd
+    // ($XDG_DATA_HOME/mcpelauncher; dentro del Flatpak, el del sandbox)
+    static QString defaultDataDir();
+    // <profilesDir>/<versión>/shader-cache, también con profileMode "shared"
+    QString shaderCacheDir(const QString &versionPath) const;
 
     // Importa un archivo (world/addon) usando el cliente con la opción -ifp
     // versionPath debe ser la ruta completa a la carpeta de la versión.
-    bool importFile(const QString &versionPath,
-                    const QString &filePath,
-                    bool useShared = false,
-                    bool useNvidia = false,
-                    bool useZink = false,
-                    bool useMangohud = false);
+    // No espera al arranque: el resultado llega por importStarted /
+    // importFailed.
+    bool importFile(const QString &versionPath, const QString &filePath,
+                    const LaunchPreset &preset);
+
+signals:
+    void importStarted(const QString &versionPath, const QString &filePath);
+    void importFailed(const QString &versionPath, const QString &filePath,
+                      const QString &reason);
 
 private:
     PathManager *m_paths;
@@ -1,12 +1,22 @@
 #ifndef MINECRAFTMANAGER_H
 #define MINECRAFTMANAGER_H
 
+#include <QHash>
 #include <QObject>
+#include <QPointer>
 #include <QStringList>
 #include <QVariant>
 
 class PathManager;
-class QProcess;
+class GameInstance;
+class GameInstanceRegistry;
+class GameLog;
+class LaunchMetrics;
+class MinecraftLaunch;
+class ProcessTelemetry;
+class TrashPurger;
+class VersionPrefetcher;
+class WorldBackup;
 
 class MinecraftManager : public QObject {
   Q_OBJECT
@@ -16,9 +26,32 @@ class MinecraftManager : public QObject {
                  lastActiveVersionChanged)
   Q_PROPERTY(bool isInstalled READ isInstalled NOTIFY isInstalledChanged)
   Q_PROPERTY(bool isRunning READ isRunning NOTIFY isRunningChanged)
+  Q_PROPERTY(bool launching READ isLaunching NOTIFY launchingChanged)
+  Q_PROPERTY(QString stopPhase READ stopPhase NOTIFY stopPhaseChanged)
+  Q_PROPERTY(int stopGraceMs READ stopGraceMs WRITE setStopGraceMs NOTIFY
+                 stopGraceMsChanged)
+  Q_PROPERTY(bool idleWorkersDuringGame READ idleWorkersDuringGame WRITE
+                 setIdleWorkersDuringGame NOTIFY idleWorkersDuringGameChanged)
+  Q_PROPERTY(bool autoRelaunch READ autoRelaunch WRITE setAutoRelaunch NOTIFY
+                 autoRelaunchChanged)
+  Q_PROPERTY(int maxRelaunchAttempts READ maxRelaunchAttempts WRITE
+                 setMaxRelaunchAttempts NOTIFY autoRelaunchChanged)
+  Q_PROPERTY(QObject *instances READ instances CONSTANT)
+  Q_PROPERTY(QObject *currentInstance READ currentInstance NOTIFY
+                 currentInstanceChanged)
+  Q_PROPERTY(QObject *telemetry READ telemetry NOTIFY currentInstanceChanged)
+  Q_PROPERTY(QObject *gameLog READ gameLog NOTIFY currentInstanceChanged)
+  Q_PROPERTY(QObject *launchMetrics READ launchMetrics CONSTANT)
   Q_PROPERTY(QString status READ status NOTIFY statusChanged)
   Q_PROPERTY(QVariantList availableVersions READ availableVersions NOTIFY
                  availableVersionsChanged)
+  Q_PROPERTY(bool trashBusy READ trashBusy NOTIFY trashBusyChanged)
+  Q_PROPERTY(double trashProgress READ trashProgress NOTIFY
+                 trashProgressChanged)
+  Q_PROPERTY(bool worldBackupBusy READ worldBackupBusy NOTIFY
+                 worldBackupBusyChanged)
+  Q_PROPERTY(double worldBackupProgress READ worldBackupProgress NOTIFY
+                 worldBackupProgressChanged)
 public:
   explicit MinecraftManager(PathManager *paths = nullptr,
                             QObject *parent = nullptr);
@@ -29,9 +62,15 @@ public:
   // Fuerza un escaneo del directorio de versiones y actualiza la cache
   Q_INVOKABLE QVariantList getAvailableVersions();
 
-  // Elimina una versión (ruta completa) y opcionalmente su perfil asociado
+  // Elimina una versión (ruta completa) y opcionalmente su perfil asociado.
+  // Las carpetas se mueven al instante a .trash y se purgan en segundo plano
+  // (trashBusy / trashProgress); no se borra una versión en marcha.
   Q_INVOKABLE void deleteVersion(const QString &versionPath,
                                  bool deleteProfile = true);
+  // Igual que deleteVersion para varias versiones (rutas o nombres), con un
+  // solo reescaneo y un solo versionsDeleted para todo el lote
+  Q_INVOKABLE void deleteVersions(const QStringList &versionPaths,
+                                  bool deleteProfile = true);
 
   // Solicita la instalación/extracción de un APK con nombre y posibles assets
   Q_INVOKABLE void installRequested(const QString &apkPath, const QString &name,
@@ -44,15 +83,73 @@ public:
   // Comportamientos mínimos/auxiliares (stubs) que pueden ampliarse
   Q_INVOKABLE bool isInstalled() const { return m_isInstalled; }
   Q_INVOKABLE bool checkInstallation();
+  // true si hay alguna instancia del juego en marcha
   Q_INVOKABLE bool isRunning() const;
+  Q_INVOKABLE bool isVersionRunning(const QString &versionName) const;
+  // true mientras alguna instancia esté entre la petición de arranque y
+  // QProcess::started / errorOccurred
+  bool isLaunching() const { return m_launching; }
   Q_INVOKABLE QString status() const;
 
-  // Control del juego
+  // Control del juego. runGame no bloquea: devuelve true si el arranque se
+  // inició y el fallo posterior se notifica con launchFailed(reason). Se
+  // pueden ejecutar varias versiones a la vez (una instancia por versión);
+  // cada una queda registrada en instances.
   Q_INVOKABLE bool runGame(const QString &versionPath, const QString &unused,
                            const QString &profile);
-  Q_INVOKABLE void stopGame();
+  // Parada asíncrona de la instancia de versionName (o de la actual si se
+  // omite): SIGTERM, espera stopGraceMs y, si sigue viva, SIGKILL. La fase
+  // de la instancia actual se publica en stopPhase ("terminating", "killing"
+  // o vacío) y el final con gameStopped(killed). Llamarla de nuevo durante
+  // la espera escala directamente a SIGKILL.
+  Q_INVOKABLE void stopGame(const QString &versionName = QString());
+  QString stopPhase() const { return m_stopPhase; }
+  // Registro de instancias (modelo con stop/kill por instancia)
+  QObject *instances() const;
+  // Última instancia lanzada; telemetry y gameLog son los suyos
+  QObject *currentInstance() const;
+  // Serie temporal de CPU/RSS/hilos/E-S del proceso del juego (modelo)
+  QObject *telemetry() const;
+  // stdout/stderr de la sesión de juego actual (modelo, acotado)
+  QObject *gameLog() const;
+  // Tiempos de arranque por versión (p50/p95 persistidos)
+  QObject *launchMetrics() const;
+  // Precarga en la caché de páginas los archivos grandes de una versión
+  // (nombre o ruta) para acelerar el siguiente arranque. Pensada para
+  // llamarse al seleccionar o pasar el ratón por una versión.
+  Q_INVOKABLE void prefetchVersion(const QString &versionPath);
+  int stopGraceMs() const { return m_stopGraceMs; }
+  // Con una sesión de juego activa, los trabajos en segundo plano del
+  // launcher (instalación, copias de mundos, precarga) bajan su hilo a
+  // prioridad idle de CPU y E/S. Activado por defecto.
+  bool idleWorkersDuringGame() const;
+  void setIdleWorkersDuringGame(bool enabled);
+  void setStopGraceMs(int ms);
+  // Relanzar una versión cuando su instancia falla (no cuando sale con
+  // código 0 o se para desde el launcher). La espera crece 2 s, 4 s, 8 s...
+  // hasta 60 s; tras maxRelaunchAttempts fallos seguidos se deja de intentar.
+  // Una instancia que aguanta kStableUptimeMs reinicia la cuenta.
+  bool autoRelaunch() const { return m_autoRelaunch; }
+  void setAutoRelaunch(bool enabled);
+  int maxRelaunchAttempts() const { return m_maxRelaunchAttempts; }
+  void setMaxRelaunchAttempts(int attempts);
+  // Opciones de arranque por versión (nombre o ruta) que aplican runGame e
+  // importSelected: gpu ("default", "nvidia", "prime", "zink"), mangohud,
+  // gamemode, detach (setsid), profileMode ("version" o "shared"), env
+  // (objeto), extraArgs (lista), cpus (lista de índices), nice, ioClass
+  // ("none", "best-effort", "idle", "realtime"), ioLevel (0-7),
+  // shaderCache y shaderCacheMaxMb. setLaunchPreset acepta un mapa parcial.
+  Q_INVOKABLE QVariantMap getLaunchPreset(const QString &versionPath) const;
+  Q_INVOKABLE bool setLaunchPreset(const QString &versionPath,
+                                   const QVariantMap &preset);
+  // Caché de shaders de la versión (en MB). pruneShaderCache la recorta en
+  // segundo plano hasta maxMb (por defecto el shaderCacheMaxMb del preset;
+  // 0 la vacía) y avisa con shaderCachePruned. No se toca mientras la
+  // versión está en marcha; al terminar cada sesión se recorta sola.
+  Q_INVOKABLE double shaderCacheSizeMb(const QString &versionPath) const;
+  Q_INVOKABLE bool pruneShaderCache(const QString &versionPath, int maxMb = -1);
   // Import a selected file into a chosen version (versionPath must be full
-  // path)
+  // path). The flags force the matching preset option on for this import.
   Q_INVOKABLE void importSelected(const QString &filePath, const QString &type,
                                   const QString &versionPath,
                                   bool useShared = false,
@@ -65,6 +162,38 @@ public:
   // as a user cancellation instead of a success.
   Q_INVOKABLE void cancelInstall();
 
+  // Mundos guardados en el perfil de una versión (id de carpeta, nombre
+  // visible y ruta completa)
+  Q_INVOKABLE QVariantList listWorlds(const QString &versionPath) const;
+
+  // Exporta un mundo a un archivo .mcworld en segundo plano. El progreso se
+  // expone en worldBackupProgress y el resultado llega por
+  // worldExportSucceeded / worldExportFailed. compressionLevel: 0 (sin
+  // compresión) a 9.
+  Q_INVOKABLE bool exportWorld(const QString &versionPath,
+                               const QString &worldId,
+                               const QString &destPath,
+                               int compressionLevel = 6);
+
+  // Copias incrementales: sólo se guardan los archivos nuevos o modificados
+  // desde el snapshot anterior. El almacén de cada mundo vive en
+  // <backupsDir>/<versión>/<mundo>.
+  Q_INVOKABLE bool backupWorld(const QString &versionPath,
+                               const QString &worldId);
+  // Snapshot de todos los mundos de todas las versiones en un solo trabajo;
+  // se omiten los que tiene abiertos una instancia en marcha
+  Q_INVOKABLE bool backupAllWorlds();
+  Q_INVOKABLE QVariantList listWorldSnapshots(const QString &versionPath,
+                                              const QString &worldId) const;
+  Q_INVOKABLE bool restoreWorldSnapshot(const QString &versionPath,
+                                        const QString &worldId,
+                                        const QString &snapshotId);
+
+  bool trashBusy() const;
+  double trashProgress() const;
+  bool worldBackupBusy() const;
+  double worldBackupProgress() const;
+
   QString installedVersion() const { return m_installedVersion; }
   QString lastActiveVersion() const { return m_lastActiveVersion; }
 
@@ -76,6 +205,21 @@ signals:
   void lastActiveVersionChanged();
   void isInstalledChanged();
   void isRunningChanged();
+  void launchingChanged();
+  void launchFailed(const QString &reason);
+  void launchPresetChanged(const QString &versionName);
+  void stopPhaseChanged();
+  void stopGraceMsChanged();
+  void idleWorkersDuringGameChanged();
+  void gameStopped(bool killed);
+  // Una instancia terminó de forma anómala. reportPath es el informe escrito
+  // en logsDir; relaunchInMs > 0 si se va a relanzar automáticamente.
+  void gameCrashed(const QString &versionName, const QString &reason,
+                   const QString &reportPath, int relaunchInMs);
+  void autoRelaunchChanged();
+  void shaderCachePruned(const QString &versionName, double freedMb,
+                         double sizeMb);
+  void currentInstanceChanged();
   void statusChanged();
   // Señal emitida después de borrar una o varias versiones (listas de rutas
   // eliminadas)
@@ -87,6 +231,20 @@ signals:
   void importSucceeded(const QString &versionPath, const QString &filePath);
   void importFailed(const QString &versionPath, const QString &filePath,
                     const QString &reason);
+  void trashBusyChanged();
+  void trashProgressChanged();
+  void trashPurged(double freedMb);
+  // Signals for world export / backup
+  void worldBackupBusyChanged();
+  void worldBackupProgressChanged();
+  void worldExportSucceeded(const QString &worldPath, const QString &destPath);
+  void worldExportFailed(const QString &worldPath, const QString &destPath,
+                         const QString &reason);
+  void worldBackupFinished(const QStringList &snapshotIds, bool ok,
+                           const QString &reason);
+  void worldRestoreFinished(const QString &worldPath,
+                            const QString &snapshotId, bool ok,
+                            const QString &reason);
 
 private:
   struct InstallContext;
@@ -96,8 +254,42 @@ private:
   bool m_isInstalled = false;
   QVariantList m_availableVersions;
   QString versionsDir() const;
+  QString profilesDir() const;
+  QString resolveVersionPath(const QString &versionPath) const;
+  QString worldsDir(const QString &versionPath) const;
+  // Carpeta del mundo dentro de worldsDir, o vacío si worldId no es un
+  // nombre de carpeta simple (contiene "/", es "." o "..")
+  QString resolveWorldPath(const QString &versionPath,
+                           const QString &worldId) const;
+  static bool isPlainName(const QString &name);
+  // true si worldPath está en el directorio de datos de una instancia viva
+  bool worldInUse(const QString &worldPath) const;
+  QString worldBackupStore(const QString &versionPath,
+                           const QString &worldId) const;
   PathManager *m_pathManager = nullptr;
-  QProcess *m_gameProcess = nullptr;
+  WorldBackup *m_worldBackup = nullptr;
+  MinecraftLaunch *m_launcher = nullptr;
+  GameInstanceRegistry *m_instances = nullptr;
+  QPointer<GameInstance> m_currentInstance;
+  ProcessTelemetry *m_idleTelemetry = nullptr;
+  GameLog *m_idleGameLog = nullptr;
+  LaunchMetrics *m_launchMetrics = nullptr;
+  VersionPrefetcher *m_prefetcher = nullptr;
+  TrashPurger *m_trash = nullptr;
+  bool m_launching = false;
+  bool m_wasRunning = false;
+  QString m_stopPhase;
+  int m_stopGraceMs = 3000;
+  void refreshGameState();
+  void handleCrash(GameInstance *instance, const QString &reason,
+                   const QString &reportPath);
+  bool m_autoRelaunch = false;
+  int m_maxRelaunchAttempts = 5;
+  // Fallos seguidos por versión (se reinicia con una sesión estable)
+  QHash<QString, int> m_relaunchAttempts;
+  static constexpr int kRelaunchBaseMs = 2000;
+  static constexpr int kRelaunchMaxMs = 60000;
+  static constexpr qint64 kStableUptimeMs = 5 * 60 * 1000;
   QString m_status;
   bool m_installCancelRequested = false;
   void handleInstallCompletion(bool ok, const QString &extractorErr);
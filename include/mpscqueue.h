@@ -0,0 +1,88 @@
+#ifndef MPSCQUEUE_H
+#define MPSCQUEUE_H
+
+#include <atomic>
+#include <utility>
+
+// Cola sin bloqueos de varios productores y un consumidor (algoritmo de
+// Dmitry Vyukov, lista enlazada intrusiva con nodo centinela). push() se
+// puede llamar desde cualquier hilo y nunca espera; tryPop() e isEmpty()
+// sólo desde el hilo consumidor.
+template <typename T>
+class MpscQueue
+{
+public:
+    MpscQueue() : m_head(&m_stub), m_tail(&m_stub) {}
+    ~MpscQueue()
+    {
+        T value;
+        while (tryPop(value)) {
+        }
+    }
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    void push(T value) { pushNode(new Node(std::move(value))); }
+
+    // false si la cola está vacía o si un productor está a mitad de push()
+    // (su elemento aparecerá en una llamada posterior)
+    bool tryPop(T &out)
+    {
+        Node *tail = m_tail;
+        Node *next = tail->next.load(std::memory_order_acquire);
+        if (tail == &m_stub) {
+            if (!next)
+                return false;
+            m_tail = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next) {
+            m_tail = next;
+            out = std::move(tail->value);
+            delete tail;
+            return true;
+        }
+        if (tail != m_head.load(std::memory_order_acquire))
+            return false;
+        // tail es el último nodo: volver a encolar el centinela para poder
+        // sacarlo sin dejar la lista vacía
+        pushNode(&m_stub);
+        next = tail->next.load(std::memory_order_acquire);
+        if (next) {
+            m_tail = next;
+            out = std::move(tail->value);
+            delete tail;
+            return true;
+        }
+        return false;
+    }
+
+    bool isEmpty() const
+    {
+        return m_tail == m_head.load(std::memory_order_acquire) &&
+               !m_tail->next.load(std::memory_order_acquire);
+    }
+
+private:
+    struct Node {
+        Node() = default;
+        explicit Node(T v) : value(std::move(v)) {}
+        std::atomic<Node *> next{nullptr};
+        T value;
+    };
+
+    void pushNode(Node *node)
+    {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        Node *prev = m_head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    // Productores y consumidor en líneas de caché distintas
+    alignas(64) std::atomic<Node *> m_head;
+    alignas(64) Node *m_tail;
+    Node m_stub;
+};
+
+#endif // MPSCQUEUE_H
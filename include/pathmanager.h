@@ -15,6 +15,7 @@ class PathManager : public QObject
     Q_PROPERTY(QString versionsDir READ versionsDir NOTIFY changed)
     Q_PROPERTY(QString profilesDir READ profilesDir NOTIFY changed)
     Q_PROPERTY(QString logsDir READ logsDir NOTIFY changed)
+    Q_PROPERTY(QString backupsDir READ backupsDir NOTIFY changed)
     Q_PROPERTY(QString configFile READ configFile NOTIFY changed)
     Q_PROPERTY(QString mcpelauncherExtract READ mcpelauncherExtract NOTIFY changed)
     Q_PROPERTY(QString mcpelauncherClient READ mcpelauncherClient NOTIFY changed)
@@ -29,6 +30,7 @@ public:
     QString versionsDir() const;
     QString profilesDir() const;
     QString logsDir() const;
+    QString backupsDir() const;
     QString configFile() const;
     QString mcpelauncherExtract() const;
     QString mcpelauncherClient() const;
@@ -62,6 +64,7 @@ private:
     QString m_versionsDir;
     QString m_profilesDir;
     QString m_logsDir;
+    QString m_backupsDir;
     QString m_configFile;
     QString m_mcpelauncherExtract;
     QString m_mcpelauncherClient;
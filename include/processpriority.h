@@ -0,0 +1,69 @@
+#ifndef PROCESSPRIORITY_H
+#define PROCESSPRIORITY_H
+
+#include <QList>
+#include <QString>
+
+// Planificación de CPU y E/S del juego y de los hilos de trabajo del
+// launcher (Linux: sched_setaffinity, setpriority, ioprio_set).
+namespace ProcessPriority {
+
+// Clases de E/S de ioprio_set; None deja la del proceso sin tocar
+enum class IoClass { None = 0, Realtime = 1, BestEffort = 2, Idle = 3 };
+
+IoClass ioClassFromString(const QString &name);
+QString ioClassToString(IoClass ioClass);
+
+struct Settings {
+  QList<int> cpus; // vacío = sin restricción de afinidad
+  int nice = 0;    // 0 = no cambiar
+  IoClass ioClass = IoClass::None;
+  int ioLevel = 4; // 0 (más prioridad) a 7
+
+  bool isDefault() const {
+    return cpus.isEmpty() && nice == 0 && ioClass == IoClass::None;
+  }
+};
+
+// pid seguido de todos sus descendientes, siguiendo
+// /proc/<pid>/task/<tid>/children desde pid (sin recorrer todo /proc)
+QList<qint64> processTree(qint64 pid);
+// Hilos de pid (/proc/<pid>/task)
+QList<qint64> tasksOf(qint64 pid);
+
+// Aplica los ajustes a todos los hilos de pid y de sus descendientes. Los
+// hilos y procesos creados después los heredan. Devuelve false si algún
+// ajuste fue rechazado (p. ej. nice negativo sin CAP_SYS_NICE).
+bool applyToProcessTree(qint64 pid, const Settings &settings);
+
+// Mientras haya una sesión de juego activa (y la opción esté habilitada)
+// los trabajos en segundo plano del launcher se ejecutan con SCHED_IDLE (o
+// SCHED_BATCH si no se podría volver atrás) y E/S idle para no competir con
+// el juego.
+void setGameSessionActive(bool active);
+void setIdleWorkersEnabled(bool enabled);
+bool idleWorkersEnabled();
+bool workersShouldIdle();
+
+// Se declara al principio de cada trabajo en segundo plano. Si procede,
+// baja la prioridad del hilo actual y la restaura al salir (los hilos del
+// pool se reutilizan para otros trabajos). Con Always la baja siempre, haya
+// juego o no: para trabajos que nunca tienen prisa (purgar la papelera).
+class WorkerScope {
+public:
+  enum class Mode { WhileGameActive, Always };
+
+  explicit WorkerScope(Mode mode = Mode::WhileGameActive);
+  ~WorkerScope();
+  WorkerScope(const WorkerScope &) = delete;
+  WorkerScope &operator=(const WorkerScope &) = delete;
+
+private:
+  bool m_lowered = false;
+  int m_policy = 0;
+  int m_ioprio = -1;
+};
+
+} // namespace ProcessPriority
+
+#endif // PROCESSPRIORITY_H
@@ -0,0 +1,123 @@
+#ifndef PROCESSTELEMETRY_H
+#define PROCESSTELEMETRY_H
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QVariantList>
+#include <QVector>
+
+class QTimer;
+
+// Muestreo periódico de /proc/<pid>/{stat,statm,io,status} para el proceso
+// del juego y todos sus descendientes. Las muestras se guardan en un buffer
+// circular de tamaño fijo que se expone como modelo de lista (una fila por
+// muestra, la más antigua primero) para poder dibujarlo desde QML.
+class ProcessTelemetry : public QAbstractListModel {
+  Q_OBJECT
+  Q_PROPERTY(bool active READ isActive NOTIFY activeChanged)
+  Q_PROPERTY(qint64 pid READ pid NOTIFY activeChanged)
+  Q_PROPERTY(int intervalMs READ intervalMs WRITE setIntervalMs NOTIFY
+                 intervalMsChanged)
+  Q_PROPERTY(int capacity READ capacity WRITE setCapacity NOTIFY
+                 capacityChanged)
+  Q_PROPERTY(double cpuPercent READ cpuPercent NOTIFY sampled)
+  Q_PROPERTY(double rssMb READ rssMb NOTIFY sampled)
+  Q_PROPERTY(double peakRssMb READ peakRssMb NOTIFY sampled)
+  Q_PROPERTY(double swapMb READ swapMb NOTIFY sampled)
+  Q_PROPERTY(int threads READ threads NOTIFY sampled)
+  Q_PROPERTY(int processCount READ processCount NOTIFY sampled)
+  Q_PROPERTY(double readMbPerSec READ readMbPerSec NOTIFY sampled)
+  Q_PROPERTY(double writeMbPerSec READ writeMbPerSec NOTIFY sampled)
+
+public:
+  enum TelemetryRoles {
+    TimeRole = Qt::UserRole + 1,
+    CpuRole,
+    RssRole,
+    SwapRole,
+    ThreadsRole,
+    ProcessCountRole,
+    ReadRateRole,
+    WriteRateRole
+  };
+
+  struct Sample {
+    qint64 timestamp = 0; // ms desde epoch
+    double cpuPercent = 0.0; // puede superar 100 con varios núcleos
+    double rssMb = 0.0;
+    double swapMb = 0.0;
+    int threads = 0;
+    int processCount = 0;
+    double readMbPerSec = 0.0;
+    double writeMbPerSec = 0.0;
+  };
+
+  explicit ProcessTelemetry(QObject *parent = nullptr);
+
+  int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex &index,
+                int role = Qt::DisplayRole) const override;
+  QHash<int, QByteArray> roleNames() const override;
+
+  // Empieza a muestrear pid (descarta la serie anterior)
+  void start(qint64 pid);
+  // Deja de muestrear; la serie se conserva para consultarla
+  void stop();
+  Q_INVOKABLE void clear();
+
+  // Serie de un campo ("cpu", "rss", "swap", "threads", "processes", "read",
+  // "write") en orden cronológico, pensada para Canvas en QML.
+  Q_INVOKABLE QVariantList series(const QString &field) const;
+  Q_INVOKABLE double maxOf(const QString &field) const;
+
+  bool isActive() const { return m_pid > 0; }
+  qint64 pid() const { return m_pid; }
+  int intervalMs() const { return m_intervalMs; }
+  void setIntervalMs(int ms);
+  int capacity() const { return m_capacity; }
+  void setCapacity(int capacity);
+
+  double cpuPercent() const { return m_last.cpuPercent; }
+  double rssMb() const { return m_last.rssMb; }
+  double peakRssMb() const { return m_peakRssMb; }
+  double swapMb() const { return m_last.swapMb; }
+  int threads() const { return m_last.threads; }
+  int processCount() const { return m_last.processCount; }
+  double readMbPerSec() const { return m_last.readMbPerSec; }
+  double writeMbPerSec() const { return m_last.writeMbPerSec; }
+
+signals:
+  void activeChanged();
+  void intervalMsChanged();
+  void capacityChanged();
+  void sampled();
+
+private:
+  struct ProcCounters {
+    qint64 cpuTicks = 0;
+    qint64 readBytes = 0;
+    qint64 writeBytes = 0;
+  };
+
+  void sampleNow();
+  void append(const Sample &sample);
+  const Sample &at(int row) const;
+  static double fieldOf(const Sample &s, const QString &field);
+
+  QTimer *m_timer = nullptr;
+  qint64 m_pid = 0;
+  int m_intervalMs = 1000;
+  int m_capacity = 600;
+
+  // Buffer circular: m_head apunta a la muestra más antigua
+  QVector<Sample> m_samples;
+  int m_head = 0;
+  int m_count = 0;
+
+  Sample m_last;
+  double m_peakRssMb = 0.0;
+  qint64 m_lastSampleMs = 0;
+  QHash<qint64, ProcCounters> m_prev;
+};
+
+#endif // PROCESSTELEMETRY_H
@@ -0,0 +1,32 @@
+#ifndef PROGRESSREPORTER_H
+#define PROGRESSREPORTER_H
+
+#include <QMetaObject>
+#include <QObject>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+// Función de progreso (0 a 1) para los trabajos en segundo plano. Se puede
+// llamar desde cualquier hilo y con cualquier frecuencia: sólo se publica un
+// evento al hilo de receiver cuando el valor cambia en décimas de
+// porcentaje, y allí se llama a setProgress. Los eventos pendientes se
+// descartan si receiver se destruye, pero el dueño debe esperar a su
+// trabajo antes de destruirse.
+template <typename Receiver>
+std::function<void(double)>
+throttledProgress(Receiver *receiver, void (Receiver::*setProgress)(double))
+{
+    auto lastReported = std::make_shared<std::atomic<int>>(-1);
+    return [receiver, setProgress, lastReported](double p) {
+        const int permille = int(p * 1000.0);
+        if (lastReported->exchange(permille) == permille)
+            return;
+        QMetaObject::invokeMethod(
+            receiver, [receiver, setProgress, p]() { (receiver->*setProgress)(p); },
+            Qt::QueuedConnection);
+    };
+}
+
+#endif // PROGRESSREPORTER_H
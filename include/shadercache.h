@@ -0,0 +1,22 @@
+#ifndef SHADERCACHE_H
+#define SHADERCACHE_H
+
+#include <QString>
+
+// Caché de shaders de la GPU de una versión (<profilesDir>/<versión>/
+// shader-cache, con subdirectorios mesa/ y nvidia/). Los drivers la llenan
+// a través de las variables de entorno que pone MinecraftLaunch::buildSpec;
+// aquí sólo se mide y se recorta.
+namespace ShaderCache {
+
+// Bytes ocupados por los archivos de dir (recursivo)
+qint64 size(const QString &dir);
+
+// Borra los archivos menos usados (por fecha de acceso o modificación)
+// hasta que dir ocupe como mucho maxBytes. Devuelve los bytes liberados.
+// Los índices de los drivers se conservan: toleran entradas que faltan.
+qint64 prune(const QString &dir, qint64 maxBytes);
+
+} // namespace ShaderCache
+
+#endif // SHADERCACHE_H
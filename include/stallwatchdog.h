@@ -0,0 +1,92 @@
+#ifndef STALLWATCHDOG_H
+#define STALLWATCHDOG_H
+
+#include <QObject>
+#include <QVariantList>
+#include <QVector>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+class QTimer;
+
+// Detector de bloqueos del hilo de la GUI. Un temporizador en el bucle de
+// eventos marca un latido cada kBeatMs; un hilo propio comprueba que el
+// latido avanza y, mientras no lo hace, anota qué operación instrumentada
+// (OperationScope) se estaba ejecutando. Cada parada de más de
+// thresholdMs se registra en el log y en un histograma por duración.
+class StallWatchdog : public QObject {
+  Q_OBJECT
+  Q_PROPERTY(int thresholdMs READ thresholdMs WRITE setThresholdMs NOTIFY
+                 thresholdChanged)
+  Q_PROPERTY(int stallCount READ stallCount NOTIFY stallsChanged)
+  // [{ label, count }], un elemento por tramo de duración
+  Q_PROPERTY(QVariantList histogram READ histogram NOTIFY stallsChanged)
+  // [{ operation, durationMs, at }], las más recientes primero
+  Q_PROPERTY(QVariantList recentStalls READ recentStalls NOTIFY stallsChanged)
+
+public:
+  // Marca una operación síncrona del hilo de la GUI ("scan", "delete",
+  // "import", "launch"...). Se anidan; fuera del hilo de la GUI no hacen
+  // nada. name debe ser un literal.
+  class OperationScope {
+  public:
+    explicit OperationScope(const char *name);
+    ~OperationScope();
+    OperationScope(const OperationScope &) = delete;
+    OperationScope &operator=(const OperationScope &) = delete;
+
+  private:
+    const char *m_previous = nullptr;
+    bool m_active = false;
+  };
+
+  explicit StallWatchdog(QObject *parent = nullptr);
+  ~StallWatchdog() override;
+
+  int thresholdMs() const { return m_thresholdMs.load(); }
+  void setThresholdMs(int ms);
+  int stallCount() const { return m_stallCount; }
+  QVariantList histogram() const;
+  QVariantList recentStalls() const;
+  Q_INVOKABLE void reset();
+
+  static constexpr int kBeatMs = 50;
+  static constexpr int kDefaultThresholdMs = 250;
+  // Límites superiores de los tramos del histograma; el último es abierto
+  static constexpr int kBucketMs[] = {500, 1000, 2000, 5000};
+  static constexpr int kBucketCount = 5;
+  static constexpr int kMaxRecent = 20;
+  // Una parada que aún dura esto se avisa desde el hilo vigilante, por si
+  // la GUI no llega a recuperarse
+  static constexpr int kHangReportMs = 5000;
+
+signals:
+  void thresholdChanged();
+  void stallsChanged();
+
+private:
+  void beat();
+  void run();
+  void recordStall(qint64 durationMs, const char *operation);
+  static qint64 monotonicMs();
+
+  QTimer *m_beatTimer = nullptr;
+  std::atomic<qint64> m_lastBeat{0};
+  std::atomic<int> m_thresholdMs{kDefaultThresholdMs};
+  // Operación vista por el hilo vigilante durante la parada en curso
+  std::atomic<const char *> m_stallOperation{nullptr};
+
+  int m_stallCount = 0;
+  int m_buckets[kBucketCount] = {};
+  QVariantList m_recent;
+
+  std::mutex m_mutex; // m_stop
+  std::condition_variable m_cv;
+  bool m_stop = false;
+  std::thread m_thread;
+};
+
+#endif // STALLWATCHDOG_H
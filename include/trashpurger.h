@@ -0,0 +1,66 @@
+#ifndef TRASHPURGER_H
+#define TRASHPURGER_H
+
+#include <QFuture>
+#include <QObject>
+#include <QStringList>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+// Borrado diferido de carpetas grandes (versiones, perfiles). La carpeta se
+// renombra al instante a un directorio .trash oculto junto a ella y el
+// contenido se elimina después en segundo plano, con prioridad baja. Lo que
+// quede en .trash si el launcher se cierra a mitad se purga en el siguiente
+// arranque.
+class TrashPurger : public QObject {
+  Q_OBJECT
+  Q_PROPERTY(bool busy READ isBusy NOTIFY busyChanged)
+  Q_PROPERTY(double progress READ progress NOTIFY progressChanged)
+
+public:
+  explicit TrashPurger(QObject *parent = nullptr);
+  // Cancela la purga en curso y espera a que termine
+  ~TrashPurger() override;
+
+  // Renombra path a <padre>/.trash/<nombre>.<ms>. Devuelve el directorio
+  // .trash usado, o vacío si no se pudo mover (path queda intacto).
+  static QString moveToTrash(const QString &path);
+
+  // Purga el contenido de los directorios .trash indicados. Si ya hay una
+  // purga en marcha, se encadenan al terminar. Sólo se borran las entradas
+  // que había al empezar; lo que moveToTrash añada mientras tanto queda
+  // para la siguiente purga.
+  void purge(const QStringList &trashRoots);
+
+  bool isBusy() const { return m_busy; }
+  double progress() const { return m_progress; }
+
+  static constexpr const char *kTrashDirName = ".trash";
+
+signals:
+  void busyChanged();
+  void progressChanged();
+  void purgeFinished(qint64 freedBytes, bool cancelled);
+
+private:
+  struct Result {
+    qint64 freedBytes = 0;
+    bool cancelled = false;
+  };
+
+  void startPending();
+  void setProgress(double progress);
+  static Result run(const QStringList &entries,
+                    const std::function<void(double)> &progressFn,
+                    const std::shared_ptr<std::atomic_bool> &cancelled);
+
+  QStringList m_pending;
+  bool m_busy = false;
+  double m_progress = 0.0;
+  std::shared_ptr<std::atomic_bool> m_cancel;
+  QFuture<Result> m_future;
+};
+
+#endif // TRASHPURGER_H
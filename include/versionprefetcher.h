@@ -0,0 +1,67 @@
+#ifndef VERSIONPREFETCHER_H
+#define VERSIONPREFETCHER_H
+
+#include <QObject>
+#include <QString>
+
+#include <atomic>
+#include <memory>
+
+class QTimer;
+
+// Calienta la caché de páginas con los archivos más grandes de una versión
+// (libminecraftpe.so, assets empaquetados...) mientras el usuario la
+// selecciona, para que el arranque del cliente no tenga que leerlos del
+// disco. Trabaja en segundo plano con posix_fadvise(WILLNEED) + readahead,
+// respetando un presupuesto de E/S, y una petición nueva cancela la anterior.
+class VersionPrefetcher : public QObject {
+  Q_OBJECT
+  Q_PROPERTY(bool busy READ isBusy NOTIFY busyChanged)
+  Q_PROPERTY(int budgetMb READ budgetMb WRITE setBudgetMb NOTIFY
+                 budgetMbChanged)
+
+public:
+  explicit VersionPrefetcher(QObject *parent = nullptr);
+  ~VersionPrefetcher() override;
+
+  // Pide precargar versionDir. Las peticiones se agrupan (el hover de la
+  // barra lateral dispara muchas) y una versión ya precargada hace poco no
+  // se vuelve a leer.
+  void prefetch(const QString &versionDir);
+  void cancel();
+
+  bool isBusy() const { return m_running > 0; }
+  int budgetMb() const { return m_budgetMb; }
+  void setBudgetMb(int mb);
+
+  // Ventana durante la que no se repite la precarga de la misma versión
+  static constexpr int kRepeatWindowMs = 5 * 60 * 1000;
+  static constexpr int kDebounceMs = 250;
+
+signals:
+  void busyChanged();
+  void budgetMbChanged();
+  void prefetchFinished(const QString &versionDir, qint64 bytes,
+                        qint64 elapsedMs, bool cancelled);
+
+private:
+  struct Result {
+    qint64 bytes = 0;
+    qint64 elapsedMs = 0;
+    bool cancelled = false;
+  };
+
+  void startPending();
+  static Result run(const QString &versionDir, qint64 budgetBytes,
+                    const std::shared_ptr<std::atomic_bool> &cancelled);
+
+  QTimer *m_debounce = nullptr;
+  QString m_pending;
+  QString m_lastDir;
+  qint64 m_lastDoneMs = 0;
+  int m_budgetMb = 768;
+  int m_running = 0;
+  std::shared_ptr<std::atomic_bool> m_cancel;
+};
+
+#endif // VERSIONPREFETCHER_H
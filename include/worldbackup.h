@@ -0,0 +1,108 @@
+#ifndef WORLDBACKUP_H
+#define WORLDBACKUP_H
+
+#include <QFuture>
+#include <QList>
+#include <QObject>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QVariantList>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+// Servicio de exportación y copias de seguridad de mundos.
+//
+// Exportación (.mcworld): la compresión se reparte en varios hilos; cada hilo
+// comprime un subconjunto de archivos en un zip temporal y al final se
+// fusionan en el .mcworld copiando los datos ya comprimidos (libzip no
+// recomprime entradas copiadas completas).
+//
+// Copias incrementales: cada mundo tiene un almacén con objetos direccionados
+// por contenido (SHA-256), un manifiesto con hash/tamaño/fecha de cada
+// archivo para no volver a leer los que no cambiaron, y un JSON por
+// snapshot que lista los objetos que lo componen.
+//
+//   <storeDir>/objects/ab/abcdef...   contenido de cada archivo
+//   <storeDir>/manifest.json          último estado conocido del mundo
+//   <storeDir>/snapshots/<id>.json    lista de archivos de cada snapshot
+class WorldBackup : public QObject {
+  Q_OBJECT
+  Q_PROPERTY(bool busy READ isBusy NOTIFY busyChanged)
+  Q_PROPERTY(double progress READ progress NOTIFY progressChanged)
+
+public:
+  using ProgressFn = std::function<void(double)>;
+  // Par (carpeta del mundo, almacén de copias de ese mundo)
+  using BackupTarget = QPair<QString, QString>;
+
+  explicit WorldBackup(QObject *parent = nullptr);
+  // Cancela el trabajo en curso y espera a que termine: sus callbacks de
+  // progreso apuntan a este objeto
+  ~WorldBackup() override;
+
+  bool isBusy() const { return m_busy; }
+  double progress() const { return m_progress; }
+
+  // Lanza la exportación en segundo plano. Devuelve false si ya hay una
+  // operación en curso. compressionLevel: 0 = sin compresión, 1-9 = deflate.
+  bool exportWorld(const QString &worldDir, const QString &destPath,
+                   int compressionLevel = 6);
+
+  // Crea un snapshot incremental de cada mundo de la lista, uno tras otro,
+  // en un único trabajo en segundo plano.
+  bool backupWorlds(const QList<BackupTarget> &targets);
+
+  // Reconstruye worldDir a partir de un snapshot del almacén.
+  bool restoreSnapshot(const QString &storeDir, const QString &snapshotId,
+                       const QString &worldDir);
+
+  // Snapshots disponibles (más reciente primero)
+  static QVariantList listSnapshots(const QString &storeDir);
+
+  // Implementaciones síncronas (usadas desde el hilo de trabajo). progressFn
+  // recibe valores entre 0 y 1 y puede llamarse desde varios hilos. Si
+  // cancelled pasa a true, abandonan el trabajo sin tocar el destino.
+  static bool writeMcworld(const QString &worldDir, const QString &destPath,
+                           int compressionLevel, const ProgressFn &progressFn,
+                           QString *error,
+                           const std::atomic_bool *cancelled = nullptr);
+  static bool writeSnapshot(const QString &worldDir, const QString &storeDir,
+                            const ProgressFn &progressFn, QString *snapshotId,
+                            QString *error,
+                            const std::atomic_bool *cancelled = nullptr);
+  static bool readSnapshot(const QString &storeDir, const QString &snapshotId,
+                           const QString &worldDir,
+                           const ProgressFn &progressFn, QString *error,
+                           const std::atomic_bool *cancelled = nullptr);
+
+signals:
+  void busyChanged();
+  void progressChanged();
+  void exportFinished(const QString &worldDir, const QString &destPath,
+                      bool ok, const QString &error);
+  void backupFinished(const QStringList &snapshotIds, bool ok,
+                      const QString &error);
+  void restoreFinished(const QString &worldDir, const QString &snapshotId,
+                       bool ok, const QString &error);
+
+private:
+  using Work = std::function<QString(const ProgressFn &,
+                                     const std::atomic_bool *cancelled)>;
+
+  // Ejecuta work en el pool y llama a done en el hilo de la GUI con el
+  // mensaje de error (vacío si todo fue bien).
+  bool startJob(const Work &work,
+                const std::function<void(const QString &)> &done);
+  void setBusy(bool busy);
+  void setProgress(double progress);
+
+  bool m_busy = false;
+  double m_progress = 0.0;
+  std::shared_ptr<std::atomic_bool> m_cancel;
+  QFuture<QString> m_future;
+};
+
+#endif // WORLDBACKUP_H
@@ -102,7 +102,7 @@ Item {
 
                             Text {
                                 anchors.centerIn: parent
-                                text: minecraftManager.isRunning ? "RUNNING" : "STOPPED"
+                                text: minecraftManager.launching ? "LAUNCHING" : (minecraftManager.isRunning ? "RUNNING" : "STOPPED")
                                 font.pixelSize: 10
                                 font.bold: true
                                 color: minecraftManager.isRunning ? themeManager.colors["accent_bright"] : themeManager.colors["text_secondary"]
@@ -119,7 +119,7 @@ Item {
                             Layout.fillWidth: true
                             Layout.preferredHeight: 50
                             text: qsTr("START GAME")
-                            enabled: !minecraftManager.isRunning
+                            enabled: !minecraftManager.instances.versionStates[minecraftManager.installedVersion]
 
                             background: Rectangle {
                                 color: parent.enabled ? (parent.pressed ? themeManager.colors["accent_pressed"] : themeManager.colors["accent"]) : themeManager.colors["button_disabled"]
@@ -134,7 +134,7 @@ Item {
                                         text: "\u25B6" // ▶
                                         font.pixelSize: 16
                                         color: themeManager.colors["text_primary"]
-                                        visible: !minecraftManager.isRunning
+                                        visible: actionButtonHome.enabled
                                         verticalAlignment: Text.AlignVCenter
                                     }
                                     Text {
@@ -214,7 +214,224 @@ Item {
             }
         }
 
-        // 3. Installed Versions Gallery
+        // 3. Live Session Telemetry (CPU / RSS del proceso del juego)
+        Rectangle {
+            id: telemetryCard
+            property var telemetry: minecraftManager.telemetry
+
+            Layout.fillWidth: true
+            Layout.preferredHeight: 200
+            visible: telemetry.active || telemetry.peakRssMb > 0
+            color: themeManager.colors["background_primary"]
+            radius: 12
+            border.color: themeManager.colors["border"]
+            border.width: 1
+
+            Connections {
+                target: telemetryCard.telemetry
+                function onSampled() { telemetryCanvas.requestPaint() }
+            }
+
+            ColumnLayout {
+                anchors.fill: parent
+                anchors.margins: 20
+                spacing: 10
+
+                RowLayout {
+                    Layout.fillWidth: true
+                    spacing: 20
+
+                    Text {
+                        text: qsTr("SESSION TELEMETRY")
+                        font.pixelSize: 12
+                        font.bold: true
+                        color: themeManager.colors["text_muted"]
+                    }
+
+                    Item { Layout.fillWidth: true }
+
+                    Text {
+                        text: "CPU " + telemetryCard.telemetry.cpuPercent.toFixed(0) + "%"
+                        font.pixelSize: 12
+                        font.bold: true
+                        color: themeManager.colors["accent"]
+                    }
+                    Text {
+                        text: "RSS " + telemetryCard.telemetry.rssMb.toFixed(0) + " MB (" + qsTr("peak") + " " + telemetryCard.telemetry.peakRssMb.toFixed(0) + ")"
+                        font.pixelSize: 12
+                        color: themeManager.colors["text_secondary"]
+                    }
+                    Text {
+                        text: telemetryCard.telemetry.threads + " " + qsTr("threads")
+                        font.pixelSize: 12
+                        color: themeManager.colors["text_muted"]
+                    }
+                    Text {
+                        text: "I/O " + telemetryCard.telemetry.readMbPerSec.toFixed(1) + " / " + telemetryCard.telemetry.writeMbPerSec.toFixed(1) + " MB/s"
+                        font.pixelSize: 12
+                        color: themeManager.colors["text_muted"]
+                    }
+                }
+
+                Canvas {
+                    id: telemetryCanvas
+                    Layout.fillWidth: true
+                    Layout.fillHeight: true
+
+                    function drawSeries(ctx, values, maxValue, strokeColor) {
+                        if (values.length < 2)
+                            return
+                        var stepX = width / (values.length - 1)
+                        ctx.beginPath()
+                        for (var i = 0; i < values.length; i++) {
+                            var x = i * stepX
+                            var y = height - (values[i] / maxValue) * (height - 2) - 1
+                            if (i === 0)
+                                ctx.moveTo(x, y)
+                            else
+                                ctx.lineTo(x, y)
+                        }
+                        ctx.strokeStyle = strokeColor
+                        ctx.lineWidth = 2
+                        ctx.stroke()
+                    }
+
+                    onPaint: {
+                        var ctx = getContext("2d")
+                        ctx.reset()
+                        var t = telemetryCard.telemetry
+                        // CPU en escala fija de 100% (o más con varios núcleos); RSS relativo a su máximo
+                        drawSeries(ctx, t.series("cpu"), Math.max(100, t.maxOf("cpu")), themeManager.colors["accent"])
+                        drawSeries(ctx, t.series("rss"), Math.max(1, t.maxOf("rss")), themeManager.colors["text_secondary"])
+                    }
+                }
+            }
+        }
+
+        // 4. Game Instances (una fila por cliente lanzado)
+        Rectangle {
+            id: instancesCard
+            property var registry: minecraftManager.instances
+
+            Layout.fillWidth: true
+            Layout.preferredHeight: 70 + instancesColumn.implicitHeight
+            visible: registry.count > 0
+            color: themeManager.colors["background_primary"]
+            radius: 12
+            border.color: themeManager.colors["border"]
+            border.width: 1
+
+            ColumnLayout {
+                anchors.fill: parent
+                anchors.margins: 20
+                spacing: 10
+
+                RowLayout {
+                    Layout.fillWidth: true
+
+                    Text {
+                        text: qsTr("GAME INSTANCES")
+                        font.pixelSize: 12
+                        font.bold: true
+                        color: themeManager.colors["text_muted"]
+                    }
+
+                    Item { Layout.fillWidth: true }
+
+                    Button {
+                        text: qsTr("Clear finished")
+                        visible: instancesCard.registry.count > instancesCard.registry.liveCount
+                        Layout.preferredHeight: 26
+                        background: Rectangle {
+                            color: parent.pressed ? themeManager.colors["border_muted"] : themeManager.colors["border"]
+                            radius: 3
+                        }
+                        contentItem: Text {
+                            text: parent.text
+                            color: themeManager.colors["text_primary"]
+                            font.pixelSize: 11
+                            horizontalAlignment: Text.AlignHCenter
+                            verticalAlignment: Text.AlignVCenter
+                        }
+                        onClicked: instancesCard.registry.clearFinished()
+                    }
+                }
+
+                ColumnLayout {
+                    id: instancesColumn
+                    Layout.fillWidth: true
+                    spacing: 6
+
+                    Repeater {
+                        model: instancesCard.registry
+                        delegate: RowLayout {
+                            Layout.fillWidth: true
+                            spacing: 15
+
+                            property bool live: status === "launching" || status === "running" || status === "stopping"
+
+                            Text {
+                                text: "#" + instanceId + "  " + version
+                                font.pixelSize: 13
+                                font.bold: true
+                                color: themeManager.colors["text_primary"]
+                                Layout.fillWidth: true
+                                elide: Text.ElideRight
+                            }
+                            Text {
+                                text: pid > 0 ? "PID " + pid : ""
+                                font.pixelSize: 12
+                                color: themeManager.colors["text_muted"]
+                            }
+                            Text {
+                                text: (stopPhase !== "" ? stopPhase : status).toUpperCase()
+                                font.pixelSize: 11
+                                font.bold: true
+                                color: status === "crashed" ? themeManager.colors["error_bright"]
+                                       : parent.live ? themeManager.colors["accent_bright"] : themeManager.colors["text_secondary"]
+                                Layout.preferredWidth: 90
+                            }
+                            Button {
+                                text: qsTr("Stop")
+                                enabled: parent.live
+                                Layout.preferredHeight: 26
+                                background: Rectangle {
+                                    color: parent.enabled ? (parent.pressed ? themeManager.colors["error_dark"] : themeManager.colors["error"]) : themeManager.colors["button_disabled"]
+                                    radius: 3
+                                }
+                                contentItem: Text {
+                                    text: parent.text
+                                    color: themeManager.colors["text_primary"]
+                                    font.pixelSize: 11
+                                    horizontalAlignment: Text.AlignHCenter
+                                    verticalAlignment: Text.AlignVCenter
+                                }
+                                onClicked: instancesCard.registry.stop(instanceId)
+                            }
+                            Button {
+                                text: qsTr("Kill")
+                                enabled: parent.live
+                                Layout.preferredHeight: 26
+                                background: Rectangle {
+                                    color: parent.enabled ? (parent.pressed ? themeManager.colors["error_dark"] : themeManager.colors["error"]) : themeManager.colors["button_disabled"]
+                                    radius: 3
+                                }
+                                contentItem: Text {
+                                    text: parent.text
+                                    color: themeManager.colors["text_primary"]
+                                    font.pixelSize: 11
+                                    horizontalAlignment: Text.AlignHCenter
+                                    verticalAlignment: Text.AlignVCenter
+                                }
+                                onClicked: instancesCard.registry.kill(instanceId)
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        // 5. Installed Versions Gallery
         ColumnLayout {
             Layout.fillWidth: true
             spacing: 20
@@ -49,6 +49,12 @@ Item {
         console.log("[HomeVersionSelected] visible =", visible, "versionName =", versionName)
     }
 
+    // Calentar la caché de disco de la versión mientras el usuario decide
+    onVersionNameChanged: {
+        if (versionName !== "")
+            minecraftManager.prefetchVersion(versionName)
+    }
+
     // Background Image
     Rectangle {
         anchors.fill: parent
@@ -269,9 +275,15 @@ Item {
                 width: 250
                 height: 60
 
-                property bool isGameRunning: minecraftManager.isRunning
+                // Estado de la instancia de esta versión (puede haber otras
+                // versiones en marcha a la vez)
+                property string versionState: minecraftManager.instances.versionStates[versionName] || ""
+                property bool isGameRunning: versionState !== ""
 
-                text: isGameRunning ? qsTr("STOP") : qsTr("PLAY")
+                text: versionState === "launching" ? qsTr("LAUNCHING")
+                      : versionState === "terminating" ? qsTr("FORCE STOP")
+                      : versionState === "killing" ? qsTr("STOPPING")
+                      : (isGameRunning ? qsTr("STOP") : qsTr("PLAY"))
 
                 background: Rectangle {
                     color: parent.isGameRunning ?
@@ -308,7 +320,7 @@ Item {
                 onClicked: {
                     if (isGameRunning) {
                         console.log("[Home] Stopping game")
-                        minecraftManager.stopGame()
+                        minecraftManager.stopGame(versionName)
                     } else {
                         console.log("[Home] Launching game version:", versionName)
                         minecraftManager.runGame(versionName, "", profileManager.currentProfile)
@@ -54,6 +54,48 @@ ApplicationWindow {
             showNotification("Import Failed", msg, "error", importWorldsAddonsCard)
             console.log("[QML] Import failed:", versionPath, filePath, reason)
         }
+
+        function onLaunchFailed(reason) {
+            showNotification("Launch Failed", reason, "error")
+            console.log("[QML] Launch failed:", reason)
+        }
+
+        function onGameCrashed(versionName, reason, reportPath, relaunchInMs) {
+            var msg = versionName + " " + reason
+            if (relaunchInMs > 0)
+                msg += "\nRelaunching in " + Math.round(relaunchInMs / 1000) + " s"
+            if (reportPath !== "")
+                msg += "\nReport: " + reportPath
+            showNotification("Game Crashed", msg, "error")
+            console.log("[QML] Game crashed:", versionName, reason, reportPath)
+        }
+
+        function onWorldExportSucceeded(worldPath, destPath) {
+            showNotification("Export Complete", "World exported to " + destPath, "info")
+            console.log("[QML] World export succeeded:", worldPath, destPath)
+        }
+
+        function onWorldExportFailed(worldPath, destPath, reason) {
+            var msg = reason && reason.length ? reason : ("Failed to export " + worldPath)
+            showNotification("Export Failed", msg, "error")
+            console.log("[QML] World export failed:", worldPath, destPath, reason)
+        }
+
+        function onWorldBackupFinished(snapshotIds, ok, reason) {
+            if (ok)
+                showNotification("Backup Complete", snapshotIds.length + " world snapshot(s) saved", "info")
+            else
+                showNotification("Backup Failed", reason, "error")
+            console.log("[QML] World backup finished:", ok, snapshotIds, reason)
+        }
+
+        function onWorldRestoreFinished(worldPath, snapshotId, ok, reason) {
+            if (ok)
+                showNotification("Restore Complete", "Restored snapshot " + snapshotId, "info")
+            else
+                showNotification("Restore Failed", reason, "error")
+            console.log("[QML] World restore finished:", ok, worldPath, snapshotId, reason)
+        }
     }
     
     Connections {
@@ -237,10 +279,8 @@ ApplicationWindow {
         secondaryTextColor: mainWindow.secondaryTextColor
 
         onDeleteRequested: function(versions) {
-            for (let i = 0; i < versions.length; i++) {
-                minecraftManager.deleteVersion(versions[i])
-            }
-            showNotification("Success", "Selected versions deleted successfully", "info", deleteVersionDialog)
+            // Resultado por onVersionsDeleted (una sola notificación)
+            minecraftManager.deleteVersions(versions)
         }
     }
 
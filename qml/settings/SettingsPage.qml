@@ -199,6 +199,12 @@ Rectangle {
                     Layout.preferredHeight: 500
                 }
 
+                // Game output of the current/last session
+                LogsTab {
+                    Layout.fillWidth: true
+                    Layout.preferredHeight: 500
+                }
+
                 // Action Buttons Row
                 RowLayout {
                     Layout.fillWidth: true
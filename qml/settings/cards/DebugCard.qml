@@ -14,6 +14,9 @@ Rectangle {
     Layout.minimumHeight: 400
 
     property bool autoScroll: true
+    property bool exportGzip: false
+    property bool exportHistory: false
+    property string exportStatus: ""
 
     function openExportLogDialog() {
         exportLogDialogLoader.active = true
@@ -36,6 +39,63 @@ Rectangle {
             font.capitalization: Font.AllUppercase
         }
 
+        // Filtros de la consola (nivel, componente, texto/regex, tiempo)
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: 10
+
+            ComboBox {
+                id: levelFilter
+                model: [qsTr("All levels"), qsTr("Info+"), qsTr("Warnings+"), qsTr("Errors")]
+                currentIndex: logFilter.minLevel
+                Layout.preferredHeight: 35
+                Layout.preferredWidth: 120
+                onActivated: logFilter.minLevel = index
+            }
+
+            ComboBox {
+                id: componentFilter
+                model: [qsTr("All components")].concat(logHandler.components)
+                currentIndex: Math.max(0, model.indexOf(logFilter.component))
+                Layout.preferredHeight: 35
+                Layout.preferredWidth: 170
+                onActivated: logFilter.component = index === 0 ? "" : model[index]
+            }
+
+            TextField {
+                id: searchField
+                Layout.fillWidth: true
+                Layout.preferredHeight: 35
+                placeholderText: logFilter.useRegex ? qsTr("Regular expression") : qsTr("Search")
+                selectByMouse: true
+                color: logFilter.regexValid ? themeManager.colors["text_primary"] : themeManager.colors["error_bright"]
+                onTextChanged: logFilter.text = text
+            }
+
+            CheckBox {
+                text: qsTr("Regex")
+                checked: logFilter.useRegex
+                onToggled: logFilter.useRegex = checked
+                Layout.preferredHeight: 35
+            }
+
+            ComboBox {
+                id: timeFilter
+                model: [qsTr("Any time"), qsTr("Last 5 min"), qsTr("Last hour")]
+                Layout.preferredHeight: 35
+                Layout.preferredWidth: 120
+                // Ventana móvil: las líneas se salen de ella con el tiempo
+                onActivated: logFilter.window = [0, 5 * 60 * 1000, 60 * 60 * 1000][index]
+            }
+
+            Text {
+                visible: logFilter.active
+                text: logFilter.count + " / " + logHandler.count
+                color: themeManager.colors["text_secondary"]
+                font.pixelSize: 11
+            }
+        }
+
         Rectangle {
             Layout.fillWidth: true
             Layout.fillHeight: true
@@ -48,7 +108,7 @@ Rectangle {
                 id: consoleListView
                 anchors.fill: parent
                 anchors.margins: 5
-                model: logHandler
+                model: logFilter
                 clip: true
                 spacing: 2
                 boundsBehavior: Flickable.StopAtBounds
@@ -88,6 +148,112 @@ Rectangle {
             }
         }
 
+        // Depuración por subsistema (qCDebug); desactivada por defecto
+        Flow {
+            Layout.fillWidth: true
+            spacing: 10
+
+            Text {
+                text: qsTr("Debug output:")
+                color: themeManager.colors["text_secondary"]
+                font.pixelSize: 12
+                font.bold: true
+                height: 30
+                verticalAlignment: Text.AlignVCenter
+            }
+
+            Repeater {
+                model: logHandler.logCategories
+                delegate: CheckBox {
+                    text: modelData.name.replace("launcher.", "")
+                    checked: modelData.debug
+                    height: 30
+                    onToggled: logHandler.setCategoryDebug(modelData.name, checked)
+                }
+            }
+        }
+
+        // Launch latency per version (request -> process / first output / window)
+        ColumnLayout {
+            id: launchTimes
+            property var metrics: minecraftManager.launchMetrics
+            Layout.fillWidth: true
+            spacing: 4
+            visible: metrics.summary.length > 0
+
+            function fmt(p50, p95) {
+                if (p50 < 0)
+                    return "-"
+                return (p50 / 1000).toFixed(2) + "s / " + (p95 / 1000).toFixed(2) + "s"
+            }
+
+            Text {
+                text: qsTr("Launch times (p50 / p95)")
+                color: themeManager.colors["text_secondary"]
+                font.pixelSize: 12
+                font.bold: true
+            }
+
+            Repeater {
+                model: launchTimes.metrics.summary
+                delegate: Text {
+                    Layout.fillWidth: true
+                    text: modelData.version + "  (" + modelData.launches + ")   "
+                          + qsTr("process") + " " + launchTimes.fmt(modelData.startedP50, modelData.startedP95) + "   "
+                          + qsTr("first output") + " " + launchTimes.fmt(modelData.firstOutputP50, modelData.firstOutputP95) + "   "
+                          + qsTr("window") + " " + launchTimes.fmt(modelData.windowP50, modelData.windowP95)
+                          + (modelData.windowMissing > 0 ? " (" + qsTr("not seen: %1").arg(modelData.windowMissing) + ")" : "")
+                    color: themeManager.colors["text_primary"]
+                    font.family: "Courier"
+                    font.pixelSize: 11
+                    elide: Text.ElideRight
+                }
+            }
+        }
+
+        // Paradas del hilo de la GUI (StallWatchdog)
+        ColumnLayout {
+            id: guiStalls
+            Layout.fillWidth: true
+            spacing: 4
+            visible: stallWatchdog.stallCount > 0
+
+            RowLayout {
+                Layout.fillWidth: true
+                spacing: 10
+
+                Text {
+                    text: qsTr("GUI stalls") + " (> " + stallWatchdog.thresholdMs + " ms): " + stallWatchdog.stallCount
+                    color: themeManager.colors["text_secondary"]
+                    font.pixelSize: 12
+                    font.bold: true
+                }
+
+                Repeater {
+                    model: stallWatchdog.histogram
+                    delegate: Text {
+                        text: modelData.label + ": " + modelData.count
+                        color: themeManager.colors["text_primary"]
+                        font.family: "Courier"
+                        font.pixelSize: 11
+                    }
+                }
+            }
+
+            Repeater {
+                model: stallWatchdog.recentStalls.slice(0, 3)
+                delegate: Text {
+                    Layout.fillWidth: true
+                    text: Qt.formatTime(new Date(modelData.at), "HH:mm:ss") + "  "
+                          + modelData.durationMs + " ms  " + modelData.operation
+                    color: themeManager.colors["text_primary"]
+                    font.family: "Courier"
+                    font.pixelSize: 11
+                    elide: Text.ElideRight
+                }
+            }
+        }
+
         RowLayout {
             Layout.fillWidth: true
             spacing: 10
@@ -158,11 +324,69 @@ Rectangle {
                     minimumPixelSize: 8
                     elide: Text.ElideRight
                 }
+                enabled: !logHandler.exporter.busy
                 onClicked: openExportLogDialog()
             }
 
+            CheckBox {
+                text: qsTr("Full history")
+                checked: debugCard.exportHistory
+                onToggled: debugCard.exportHistory = checked
+                Layout.preferredHeight: 35
+            }
+
+            CheckBox {
+                text: qsTr("Gzip")
+                checked: debugCard.exportGzip
+                onToggled: debugCard.exportGzip = checked
+                Layout.preferredHeight: 35
+            }
+
+            // Archivos de log de días anteriores y rotados, en .gz
+            CheckBox {
+                text: qsTr("Compress old logs")
+                checked: logHandler.compressRotatedLogs
+                onToggled: logHandler.compressRotatedLogs = checked
+                Layout.preferredHeight: 35
+            }
+
+            // Progreso de la exportación en segundo plano
+            ProgressBar {
+                visible: logHandler.exporter.busy
+                value: logHandler.exporter.progress
+                Layout.preferredWidth: 100
+            }
+
+            Text {
+                visible: !logHandler.exporter.busy && debugCard.exportStatus.length > 0
+                text: debugCard.exportStatus
+                color: themeManager.colors["text_secondary"]
+                font.pixelSize: 11
+                elide: Text.ElideMiddle
+                Layout.maximumWidth: 200
+            }
+
             Item { Layout.fillWidth: true }
-            
+
+            // Memoria de la consola: uso actual / presupuesto
+            Text {
+                text: (logHandler.memoryUsage / (1024 * 1024)).toFixed(1) + " / "
+                      + logHandler.memoryBudgetMb + " MB"
+                color: logHandler.memoryUsage > logHandler.memoryBudgetMb * 1024 * 1024 * 0.9
+                       ? themeManager.colors["text_primary"] : themeManager.colors["text_secondary"]
+                font.pixelSize: 11
+            }
+
+            ComboBox {
+                id: memoryBudgetCombo
+                model: [4, 16, 64, 256]
+                currentIndex: Math.max(0, model.indexOf(logHandler.memoryBudgetMb))
+                displayText: currentValue + " MB"
+                Layout.preferredHeight: 35
+                Layout.preferredWidth: 100
+                onActivated: logHandler.memoryBudgetMb = model[index]
+            }
+
             CheckBox {
                 id: autoScrollCheck
                 text: qsTr("Auto-scroll")
@@ -175,6 +399,18 @@ Rectangle {
         }
     }
 
+    Connections {
+        target: logHandler.exporter
+        function onFinished(path, ok, error) {
+            if (!ok)
+                debugCard.exportStatus = qsTr("Export failed: %1").arg(error)
+            else if (error)
+                debugCard.exportStatus = qsTr("Exported to %1 (%2)").arg(path).arg(error)
+            else
+                debugCard.exportStatus = qsTr("Exported to %1").arg(path)
+        }
+    }
+
     Loader {
         id: exportLogDialogLoader
         active: false
@@ -187,9 +423,12 @@ Rectangle {
             title: "Export Log File"
             folder: shortcuts.home
             selectExisting: false
-            nameFilters: ["Log files (*.log)", "All files (*)"]
+            nameFilters: debugCard.exportGzip
+                         ? ["Compressed log files (*.log.gz)", "All files (*)"]
+                         : ["Log files (*.log)", "All files (*)"]
             onAccepted: {
-                logHandler.saveLog(fileUrl)
+                debugCard.exportStatus = ""
+                logHandler.exportLog(fileUrl, debugCard.exportGzip, debugCard.exportHistory)
                 exportLogDialogLoader.active = false
             }
             onRejected: {
@@ -1,11 +1,16 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
+import QtQuick.Dialogs 1.3
 
 Rectangle {
+    id: logsTab
     color: themeManager.colors["surface_card"]
     opacity: 0.95
     radius: 8
+
+    property var gameLog: minecraftManager.gameLog
+    property bool autoScroll: true
     
     ColumnLayout {
         anchors.fill: parent
@@ -17,13 +22,19 @@ Rectangle {
             spacing: 10
             
             Text {
-                text: qsTr("Event Log")
+                text: qsTr("Game Output")
                 font.pixelSize: 16
                 font.bold: true
                 color: themeManager.colors["text_primary"]
             }
             
-            Item { Layout.fillWidth: true }
+            Text {
+                text: logsTab.gameLog.active ? logsTab.gameLog.sessionFile : ""
+                font.pixelSize: 11
+                color: themeManager.colors["text_secondary"]
+                elide: Text.ElideMiddle
+                Layout.fillWidth: true
+            }
             
             Button {
                 text: qsTr("Clear")
@@ -40,9 +51,7 @@ Rectangle {
                     verticalAlignment: Text.AlignVCenter
                 }
                 
-                onClicked: {
-                    logArea.clear()
-                }
+                onClicked: logsTab.gameLog.clear()
             }
             
             Button {
@@ -61,39 +70,53 @@ Rectangle {
                 }
                 
                 onClicked: {
-                    // TODO: Implementar exportación de logs
-                    console.log("[QML] Exportar logs")
+                    exportGameLogDialogLoader.active = true
+                    if (exportGameLogDialogLoader.item)
+                        exportGameLogDialogLoader.item.open()
                 }
             }
         }
         
-        ScrollView {
+        Rectangle {
             Layout.fillWidth: true
             Layout.fillHeight: true
+            color: themeManager.colors["background_primary"]
+            radius: 4
+            border.color: themeManager.colors["border"]
             clip: true
-            
-            TextArea {
-                id: logArea
-                readOnly: true
-                wrapMode: TextArea.Wrap
-                selectByMouse: true
-                font.family: "Monospace"
-                font.pixelSize: 11
-                color: themeManager.colors["text_primary"]
-                
-                background: Rectangle {
-                    color: themeManager.colors["background_primary"]
-                    radius: 4
-                    border.color: themeManager.colors["border"]
+
+            ListView {
+                id: gameLogView
+                anchors.fill: parent
+                anchors.margins: 5
+                model: logsTab.gameLog
+                clip: true
+                boundsBehavior: Flickable.StopAtBounds
+
+                ScrollBar.vertical: ScrollBar {
+                    active: true
+                    policy: ScrollBar.AsNeeded
                 }
-                
-                // Función para agregar líneas al log
-                function append(message) {
-                    var timestamp = Qt.formatDateTime(new Date(), "hh:mm:ss")
-                    logArea.text += "[" + timestamp + "] " + message + "\n"
-                    
-                    // Auto-scroll al final
-                    logArea.cursorPosition = logArea.length
+
+                delegate: Text {
+                    width: gameLogView.width - 10
+                    text: "[" + timestamp + "] " + message
+                    color: isStderr ? themeManager.colors["error_bright"] : themeManager.colors["text_primary"]
+                    font.family: "Monospace"
+                    font.pixelSize: 11
+                    wrapMode: Text.Wrap
+                    textFormat: Text.PlainText
+                }
+
+                onCountChanged: {
+                    if (logsTab.autoScroll)
+                        gameLogView.positionViewAtEnd()
+                }
+
+                onFlickStarted: logsTab.autoScroll = false
+                onAtYEndChanged: {
+                    if (atYEnd)
+                        logsTab.autoScroll = true
                 }
             }
         }
@@ -159,4 +182,22 @@ Rectangle {
             }
         }
     }
+
+    Loader {
+        id: exportGameLogDialogLoader
+        active: false
+        sourceComponent: FileDialog {
+            title: "Export Game Log"
+            folder: shortcuts.home
+            selectExisting: false
+            nameFilters: ["Log files (*.log)", "All files (*)"]
+            onAccepted: {
+                logsTab.gameLog.saveLog(fileUrl)
+                exportGameLogDialogLoader.active = false
+            }
+            onRejected: {
+                exportGameLogDialogLoader.active = false
+            }
+        }
+    }
 }
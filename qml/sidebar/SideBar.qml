@@ -238,6 +238,10 @@ Rectangle {
                                 id: versionMouse
                                 anchors.fill: parent
                                 hoverEnabled: true
+                                onContainsMouseChanged: {
+                                    if (containsMouse)
+                                        minecraftManager.prefetchVersion(versionPath !== "" ? versionPath : versionName)
+                                }
                                 onClicked: {
                                     // Refrescar la lista al seleccionar una versión
                                     minecraftManager.getAvailableVersions()
@@ -0,0 +1,142 @@
+#include "../include/consolemirror.h"
+
+#include <chrono>
+#include <cerrno>
+
+#include <unistd.h>
+
+namespace {
+// Un volcado por cada tanto acumulado aunque no haya pasado el intervalo
+constexpr int kMaxBufferBytes = 64 * 1024;
+
+std::atomic<bool> g_destroyed{false};
+} // namespace
+
+ConsoleMirror &ConsoleMirror::instance()
+{
+    // Sobrevive a LogHandler: los mensajes de después de destruirlo también
+    // se imprimen, y al salir se vacía lo pendiente
+    static ConsoleMirror mirror;
+    return mirror;
+}
+
+ConsoleMirror::ConsoleMirror()
+{
+    m_buffer.reserve(kMaxBufferBytes);
+    m_thread = std::thread([this]() { run(); });
+}
+
+ConsoleMirror::~ConsoleMirror()
+{
+    g_destroyed.store(true, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_one();
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+void ConsoleMirror::print(QtMsgType type, const QString &msg)
+{
+    const int fd = (type == QtInfoMsg || type == QtDebugMsg) ? 1 : 2;
+    QByteArray text = msg.toLocal8Bit();
+    text.append('\n');
+
+    if (g_destroyed.load(std::memory_order_acquire)) {
+        writeAll(fd, text);
+        return;
+    }
+    if (type == QtFatalMsg) {
+        // Lo encolado antes sale primero. El hilo de escritura no emite
+        // mensajes, pero si el fatal viniera de él esperarle no acabaría.
+        ConsoleMirror &mirror = instance();
+        if (std::this_thread::get_id() != mirror.m_thread.get_id())
+            mirror.flush(kFatalFlushTimeoutMs);
+        writeAll(fd, text);
+        return;
+    }
+    instance().write(fd, std::move(text), type != QtDebugMsg && type != QtInfoMsg);
+}
+
+void ConsoleMirror::write(int fd, QByteArray text, bool urgent)
+{
+    m_queue.push({fd, std::move(text)});
+    if (!urgent)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_wake = true;
+    }
+    m_cv.notify_one();
+}
+
+bool ConsoleMirror::flush(int timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const quint64 ticket = ++m_flushRequested;
+    m_wake = true;
+    m_cv.notify_one();
+    return m_flushedCv.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+                                [this, ticket]() { return m_flushed >= ticket || m_stop; });
+}
+
+void ConsoleMirror::run()
+{
+    for (;;) {
+        bool stop;
+        quint64 flushTicket;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait_for(lock, std::chrono::milliseconds(kFlushIntervalMs),
+                          [this]() { return m_stop || m_wake; });
+            m_wake = false;
+            stop = m_stop;
+            flushTicket = m_flushRequested;
+        }
+        flushQueue();
+        if (flushTicket != m_flushed) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_flushed = flushTicket;
+            }
+            m_flushedCv.notify_all();
+        }
+        if (stop)
+            return;
+    }
+}
+
+void ConsoleMirror::flushQueue()
+{
+    // Las líneas salen en el orden en que llegaron aunque alternen entre
+    // stdout y stderr: al cambiar de descriptor se vuelca lo acumulado
+    Line line;
+    while (m_queue.tryPop(line)) {
+        if (line.fd != m_bufferFd || m_buffer.size() + line.text.size() > kMaxBufferBytes) {
+            writeAll(m_bufferFd, m_buffer);
+            m_buffer.resize(0); // conserva la capacidad reservada
+            m_bufferFd = line.fd;
+        }
+        m_buffer.append(line.text);
+    }
+    writeAll(m_bufferFd, m_buffer);
+    m_buffer.resize(0);
+}
+
+void ConsoleMirror::writeAll(int fd, const QByteArray &data)
+{
+    const char *p = data.constData();
+    qint64 left = data.size();
+    while (left > 0) {
+        const ssize_t n = ::write(fd, p, size_t(left));
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return; // consola cerrada: no hay dónde avisar
+        }
+        p += n;
+        left -= n;
+    }
+}
@@ -0,0 +1,274 @@
+#include "../include/gameinstance.h"
+#include "../include/gamelog.h"
+#include "../include/processtelemetry.h"
+#include "../include/logcategories.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QSaveFile>
+#include <QTimer>
+
+#include <cstring>
+
+GameInstance::GameInstance(int id, const QString &versionName,
+                           const QString &versionPath, const QString &profile,
+                           QObject *parent)
+    : QObject(parent), m_id(id), m_versionName(versionName),
+      m_versionPath(versionPath), m_profile(profile) {
+  m_telemetry = new ProcessTelemetry(this);
+  m_gameLog = new GameLog(this);
+
+  m_stopTimer = new QTimer(this);
+  m_stopTimer->setSingleShot(true);
+  connect(m_stopTimer, &QTimer::timeout, this, &GameInstance::escalateStop);
+}
+
+QObject *GameInstance::telemetry() const { return m_telemetry; }
+
+QObject *GameInstance::gameLog() const { return m_gameLog; }
+
+bool GameInstance::isLive() const {
+  return m_status == QLatin1String("launching") ||
+         m_status == QLatin1String("running") ||
+         m_status == QLatin1String("stopping");
+}
+
+void GameInstance::setStatus(const QString &status) {
+  if (m_status == status)
+    return;
+  m_status = status;
+  emit statusChanged();
+}
+
+void GameInstance::start(const LaunchSpec &spec,
+                         const ProcessPriority::Settings &scheduling,
+                         const QString &logsDir, LaunchMetrics *metrics) {
+  m_metrics = metrics;
+  m_logsDir = logsDir;
+  if (m_metrics)
+    m_session = m_metrics->begin(m_versionName);
+  m_gameLog->beginSession(m_versionName, logsDir);
+
+  m_process = new QProcess(this);
+  QProcess *proc = m_process;
+
+  // La salida se lee a medida que llega: si nadie vacía los pipes, un
+  // cliente muy verboso acaba bloqueado en write().
+  connect(proc, &QProcess::readyReadStandardOutput, this,
+          [this]() { readOutput(false); });
+  connect(proc, &QProcess::readyReadStandardError, this,
+          [this]() { readOutput(true); });
+
+  // El arranque se resuelve de forma asíncrona: la GUI sigue respondiendo
+  // aunque el binario esté en un disco frío o dentro de Flatpak.
+  connect(proc, &QProcess::started, this, [this, proc, scheduling]() {
+    m_pid = proc->processId();
+    m_startedAt = QDateTime::currentMSecsSinceEpoch();
+    qCDebug(lcGame) << "[GameInstance]" << m_id << m_versionName
+                    << "started, pid" << m_pid;
+    if (m_metrics)
+      m_metrics->markStarted(m_session);
+    // Afinidad, nice e ioprio se aplican nada más arrancar: los hilos que
+    // cree el cliente después los heredan
+    ProcessPriority::applyToProcessTree(m_pid, scheduling);
+    m_telemetry->start(m_pid);
+    setStatus(QStringLiteral("running"));
+    emit started();
+  });
+
+  connect(proc, &QProcess::errorOccurred, this,
+          [this, proc](QProcess::ProcessError error) {
+            if (error != QProcess::FailedToStart)
+              return;
+            const QString reason = proc->errorString();
+            qWarning() << "[GameInstance]" << m_id << m_versionName
+                       << "failed to start:" << reason;
+            m_gameLog->endSession();
+            if (m_metrics)
+              m_metrics->finish(m_session);
+            setStatus(QStringLiteral("failed"));
+            emit launchFailed(reason);
+          });
+
+  connect(proc, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+          this, [this](int code, QProcess::ExitStatus es) {
+            const bool killed = m_stopPhase == QLatin1String("killing");
+            m_finishedAt = QDateTime::currentMSecsSinceEpoch();
+            m_stopTimer->stop();
+            m_telemetry->stop();
+            readOutput(false);
+            readOutput(true);
+            m_gameLog->endSession();
+            if (m_metrics)
+              m_metrics->finish(m_session);
+
+            classifyExit(code, es);
+            qCDebug(lcGame) << "[GameInstance]" << m_id << m_versionName
+                            << "exited:" << exitReason() << "after"
+                            << uptimeMs() << "ms";
+            m_stopPhase.clear();
+            if (hasCrashed()) {
+              m_crashReport = writeCrashReport();
+              setStatus(QStringLiteral("crashed"));
+              emit crashed(exitReason(), m_crashReport);
+            } else {
+              setStatus(QStringLiteral("exited"));
+            }
+            emit finished(code, es, killed);
+          });
+
+  setStatus(QStringLiteral("launching"));
+  MinecraftLaunch::start(proc, spec);
+}
+
+qint64 GameInstance::uptimeMs() const {
+  if (m_startedAt == 0)
+    return 0;
+  const qint64 end =
+      m_finishedAt > 0 ? m_finishedAt : QDateTime::currentMSecsSinceEpoch();
+  return end - m_startedAt;
+}
+
+void GameInstance::classifyExit(int code, QProcess::ExitStatus status) {
+  m_exitCode = code;
+  m_exitSignal = 0;
+  if (status == QProcess::CrashExit) {
+    // En Unix QProcess deja el número de señal en exitCode
+    m_exitSignal = code;
+  } else if (code > 128 && code < 128 + 65) {
+    // Un envoltorio (gamemoderun, mangohud) propaga la señal como 128 + n
+    m_exitSignal = code - 128;
+  }
+
+  if (m_stopRequested)
+    m_exitKind = QStringLiteral("stopped");
+  else if (m_exitSignal != 0)
+    m_exitKind = QStringLiteral("signal");
+  else if (code != 0)
+    m_exitKind = QStringLiteral("error");
+  else
+    m_exitKind = QStringLiteral("clean");
+}
+
+QString GameInstance::exitReason() const {
+  if (m_exitKind.isEmpty())
+    return QString();
+  if (m_exitKind == QLatin1String("stopped"))
+    return QStringLiteral("stopped by the launcher");
+  if (m_exitKind == QLatin1String("clean"))
+    return QStringLiteral("exited normally");
+
+  QString reason;
+  if (m_exitSignal != 0)
+    reason = QStringLiteral("killed by signal %1 (%2)")
+                 .arg(m_exitSignal)
+                 .arg(QString::fromLocal8Bit(::strsignal(m_exitSignal)));
+  else
+    reason = QStringLiteral("exited with code %1").arg(m_exitCode);
+  // Un fallo en los primeros segundos suele ser de arranque (bibliotecas,
+  // GPU, datos corruptos) y no del juego en sí
+  if (uptimeMs() < 10000)
+    reason += QStringLiteral(" during startup");
+  return reason;
+}
+
+QString GameInstance::writeCrashReport() const {
+  if (m_logsDir.isEmpty())
+    return QString();
+  QDir().mkpath(m_logsDir);
+  const QString path = QDir(m_logsDir).filePath(
+      QStringLiteral("crash-%1-%2.txt")
+          .arg(m_versionName,
+               QDateTime::fromMSecsSinceEpoch(m_finishedAt)
+                   .toString("yyyyMMdd-HHmmss")));
+
+  QSaveFile f(path);
+  if (!f.open(QIODevice::WriteOnly)) {
+    qWarning() << "[GameInstance] cannot write crash report" << path
+               << f.errorString();
+    return QString();
+  }
+
+  QByteArray out;
+  out += "Version: " + m_versionName.toUtf8() + '\n';
+  out += "Version path: " + m_versionPath.toUtf8() + '\n';
+  out += "Profile: " + m_profile.toUtf8() + '\n';
+  out += "PID: " + QByteArray::number(m_pid) + '\n';
+  out += "Started: " +
+         QDateTime::fromMSecsSinceEpoch(m_startedAt).toString(Qt::ISODate)
+             .toUtf8() +
+         '\n';
+  out += "Uptime ms: " + QByteArray::number(uptimeMs()) + '\n';
+  out += "Exit: " + exitReason().toUtf8() + '\n';
+  out += "Peak RSS MB: " + QByteArray::number(m_telemetry->peakRssMb(), 'f', 1) +
+         '\n';
+  out += "Session log: " + m_gameLog->sessionFile().toUtf8() + '\n';
+  out += "\n--- Last output ---\n";
+  out += m_gameLog->tail(kCrashTailBytes);
+
+  f.write(out);
+  if (!f.commit()) {
+    qWarning() << "[GameInstance] cannot commit crash report" << path
+               << f.errorString();
+    return QString();
+  }
+  qWarning() << "[GameInstance]" << m_versionName << "crash report:" << path;
+  return path;
+}
+
+void GameInstance::readOutput(bool isStderr) {
+  if (!m_process)
+    return;
+  const QByteArray chunk = isStderr ? m_process->readAllStandardError()
+                                    : m_process->readAllStandardOutput();
+  if (chunk.isEmpty())
+    return;
+  if (m_metrics && !isStderr)
+    m_metrics->observeOutput(m_session, chunk);
+  m_gameLog->appendData(chunk, isStderr);
+}
+
+void GameInstance::stop() {
+  qCDebug(lcGame) << "[GameInstance]" << m_id << "stop() phase:" << m_stopPhase;
+  if (!m_process || m_process->state() == QProcess::NotRunning)
+    return;
+  m_stopRequested = true;
+
+  // Segunda pulsación mientras se espera a SIGTERM: no seguir esperando.
+  if (!m_stopPhase.isEmpty()) {
+    escalateStop();
+    return;
+  }
+
+  // Un proceso que aún no ha arrancado no puede atender SIGTERM.
+  if (m_process->state() == QProcess::Starting) {
+    escalateStop();
+    return;
+  }
+
+  m_process->terminate();
+  m_stopPhase = QStringLiteral("terminating");
+  // stopPhase cambia aunque status ya fuera "stopping"
+  m_status = QStringLiteral("stopping");
+  emit statusChanged();
+  m_stopTimer->start(m_stopGraceMs);
+}
+
+void GameInstance::kill() {
+  m_stopRequested = true;
+  escalateStop();
+}
+
+void GameInstance::escalateStop() {
+  m_stopTimer->stop();
+  if (!m_process || m_process->state() == QProcess::NotRunning)
+    return;
+  qWarning() << "[GameInstance]" << m_id << "escalating to SIGKILL after"
+             << m_stopPhase;
+  m_stopPhase = QStringLiteral("killing");
+  // stopPhase cambia aunque status ya fuera "stopping"
+  m_status = QStringLiteral("stopping");
+  emit statusChanged();
+  m_process->kill();
+}
@@ -0,0 +1,175 @@
+#include "../include/gameinstanceregistry.h"
+#include "../include/gameinstance.h"
+
+#include <QDebug>
+
+GameInstanceRegistry::GameInstanceRegistry(QObject *parent)
+    : QAbstractListModel(parent) {}
+
+int GameInstanceRegistry::rowCount(const QModelIndex &parent) const {
+  if (parent.isValid())
+    return 0;
+  return m_instances.size();
+}
+
+QVariant GameInstanceRegistry::data(const QModelIndex &index, int role) const {
+  if (!index.isValid() || index.row() < 0 ||
+      index.row() >= m_instances.size())
+    return QVariant();
+
+  GameInstance *inst = m_instances.at(index.row());
+  switch (role) {
+  case IdRole:
+    return inst->instanceId();
+  case VersionRole:
+    return inst->versionName();
+  case ProfileRole:
+    return inst->profile();
+  case PidRole:
+    return inst->pid();
+  case StatusRole:
+    return inst->status();
+  case StopPhaseRole:
+    return inst->stopPhase();
+  case StartedAtRole:
+    return inst->startedAt();
+  case InstanceRole:
+    return QVariant::fromValue<QObject *>(inst);
+  default:
+    return QVariant();
+  }
+}
+
+QHash<int, QByteArray> GameInstanceRegistry::roleNames() const {
+  QHash<int, QByteArray> roles;
+  roles[IdRole] = "instanceId";
+  roles[VersionRole] = "version";
+  roles[ProfileRole] = "profile";
+  roles[PidRole] = "pid";
+  roles[StatusRole] = "status";
+  roles[StopPhaseRole] = "stopPhase";
+  roles[StartedAtRole] = "startedAt";
+  roles[InstanceRole] = "instance";
+  return roles;
+}
+
+int GameInstanceRegistry::rowOf(const GameInstance *instance) const {
+  for (int i = 0; i < m_instances.size(); ++i)
+    if (m_instances.at(i) == instance)
+      return i;
+  return -1;
+}
+
+void GameInstanceRegistry::add(GameInstance *instance) {
+  instance->setParent(this);
+  connect(instance, &GameInstance::statusChanged, this, [this, instance]() {
+    const int row = rowOf(instance);
+    if (row < 0)
+      return;
+    const QModelIndex idx = index(row);
+    emit dataChanged(idx, idx,
+                     {PidRole, StatusRole, StopPhaseRole, StartedAtRole});
+    emit instancesChanged();
+  });
+
+  pruneFinished();
+  beginInsertRows(QModelIndex(), m_instances.size(), m_instances.size());
+  m_instances.append(instance);
+  endInsertRows();
+  emit countChanged();
+  emit instancesChanged();
+}
+
+GameInstance *GameInstanceRegistry::find(int instanceId) const {
+  for (GameInstance *inst : m_instances)
+    if (inst->instanceId() == instanceId)
+      return inst;
+  return nullptr;
+}
+
+GameInstance *
+GameInstanceRegistry::liveForVersion(const QString &versionName) const {
+  for (GameInstance *inst : m_instances)
+    if (inst->isLive() && inst->versionName() == versionName)
+      return inst;
+  return nullptr;
+}
+
+GameInstance *
+GameInstanceRegistry::liveForDataDir(const QString &dataDir) const {
+  for (GameInstance *inst : m_instances)
+    if (inst->isLive() && inst->dataDir() == dataDir)
+      return inst;
+  return nullptr;
+}
+
+QList<GameInstance *> GameInstanceRegistry::liveInstances() const {
+  QList<GameInstance *> live;
+  for (GameInstance *inst : m_instances)
+    if (inst->isLive())
+      live.append(inst);
+  return live;
+}
+
+int GameInstanceRegistry::liveCount() const {
+  return liveInstances().size();
+}
+
+QVariantMap GameInstanceRegistry::versionStates() const {
+  QVariantMap states;
+  for (GameInstance *inst : m_instances) {
+    if (!inst->isLive())
+      continue;
+    states[inst->versionName()] =
+        inst->stopPhase().isEmpty() ? inst->status() : inst->stopPhase();
+  }
+  return states;
+}
+
+QObject *GameInstanceRegistry::instance(int instanceId) const {
+  return find(instanceId);
+}
+
+void GameInstanceRegistry::stop(int instanceId) {
+  if (GameInstance *inst = find(instanceId))
+    inst->stop();
+}
+
+void GameInstanceRegistry::kill(int instanceId) {
+  if (GameInstance *inst = find(instanceId))
+    inst->kill();
+}
+
+void GameInstanceRegistry::stopAll() {
+  for (GameInstance *inst : liveInstances())
+    inst->stop();
+}
+
+void GameInstanceRegistry::clearFinished() {
+  for (int i = m_instances.size() - 1; i >= 0; --i) {
+    if (m_instances.at(i)->isLive())
+      continue;
+    beginRemoveRows(QModelIndex(), i, i);
+    GameInstance *inst = m_instances.takeAt(i);
+    endRemoveRows();
+    inst->deleteLater();
+  }
+  emit countChanged();
+  emit instancesChanged();
+}
+
+void GameInstanceRegistry::pruneFinished() {
+  // Las terminadas más antiguas primero
+  int finished = m_instances.size() - liveCount();
+  for (int i = 0; i < m_instances.size() && finished >= kKeepFinished;) {
+    if (m_instances.at(i)->isLive()) {
+      ++i;
+      continue;
+    }
+    beginRemoveRows(QModelIndex(), i, i);
+    GameInstance *inst = m_instances.takeAt(i);
+    endRemoveRows();
+    inst->deleteLater();
+    --finished;
+  }
+}
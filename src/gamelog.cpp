@@ -0,0 +1,313 @@
+#include "../include/gamelog.h"
+#include "../include/logcategories.h"
+
+#include <QClipboard>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QGuiApplication>
+#include <QTimer>
+#include <QUrl>
+
+namespace {
+// Una "línea" sin salto de línea no puede crecer sin límite si el cliente
+// escribe datos binarios o una barra de progreso con \r.
+constexpr int kMaxPendingBytes = 64 * 1024;
+} // namespace
+
+GameLog::GameLog(QObject *parent) : QAbstractListModel(parent) {
+  m_lines.resize(m_maxLines);
+  m_flushTimer = new QTimer(this);
+  m_flushTimer->setSingleShot(true);
+  m_flushTimer->setInterval(kFlushIntervalMs);
+  connect(m_flushTimer, &QTimer::timeout, this, &GameLog::flushFile);
+}
+
+GameLog::~GameLog() { endSession(); }
+
+int GameLog::rowCount(const QModelIndex &parent) const {
+  if (parent.isValid())
+    return 0;
+  return m_count;
+}
+
+const GameLog::Line &GameLog::at(int row) const {
+  return m_lines[(m_head + row) % m_maxLines];
+}
+
+QVariant GameLog::data(const QModelIndex &index, int role) const {
+  if (!index.isValid() || index.row() < 0 || index.row() >= m_count)
+    return QVariant();
+
+  const Line &line = at(index.row());
+  switch (role) {
+  case TimeRole:
+    return line.time;
+  case MessageRole:
+    return line.text;
+  case StderrRole:
+    return line.isStderr;
+  default:
+    return QVariant();
+  }
+}
+
+QString GameLog::timeFor(qint64 timestamp) {
+  // data() se llama en cada repintado: la hora se formatea al recibir la
+  // línea y no por fila visible
+  const qint64 second = timestamp / 1000;
+  if (second != m_timeSecond) {
+    m_timeSecond = second;
+    m_time = QDateTime::fromMSecsSinceEpoch(second * 1000).toString("hh:mm:ss");
+  }
+  return m_time;
+}
+
+QHash<int, QByteArray> GameLog::roleNames() const {
+  QHash<int, QByteArray> roles;
+  roles[TimeRole] = "timestamp";
+  roles[MessageRole] = "message";
+  roles[StderrRole] = "isStderr";
+  return roles;
+}
+
+void GameLog::beginSession(const QString &versionName,
+                           const QString &logsDir) {
+  endSession();
+  clear();
+  m_fileBuffer.clear();
+
+  if (logsDir.isEmpty())
+    return;
+  QDir().mkpath(logsDir);
+  pruneSessions(logsDir);
+
+  const QString name =
+      QStringLiteral("game-%1-%2.log")
+          .arg(versionName,
+               QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss"));
+  m_file.setFileName(QDir(logsDir).filePath(name));
+  if (!m_file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+    qWarning() << "[GameLog] cannot open session log" << m_file.fileName()
+               << m_file.errorString();
+  } else {
+    qCDebug(lcGame) << "[GameLog] session log:" << m_file.fileName();
+  }
+  emit sessionChanged();
+}
+
+void GameLog::appendData(const QByteArray &chunk, bool isStderr) {
+  if (chunk.isEmpty())
+    return;
+
+  QByteArray &pending = isStderr ? m_pendingErr : m_pendingOut;
+  pending.append(chunk);
+
+  const qint64 now = QDateTime::currentMSecsSinceEpoch();
+  const QString time = timeFor(now);
+  QVector<Line> lines;
+  int start = 0;
+  for (;;) {
+    const int nl = pending.indexOf('\n', start);
+    if (nl < 0)
+      break;
+    int end = nl;
+    if (end > start && pending.at(end - 1) == '\r')
+      --end;
+    lines.append({now,
+                  QString::fromUtf8(pending.constData() + start, end - start),
+                  isStderr, time});
+    start = nl + 1;
+  }
+  pending.remove(0, start);
+  if (pending.size() > kMaxPendingBytes) {
+    lines.append({now, QString::fromUtf8(pending), isStderr, time});
+    pending.clear();
+  }
+
+  if (!lines.isEmpty())
+    appendLines(lines);
+}
+
+void GameLog::endSession() {
+  QVector<Line> rest;
+  const qint64 now = QDateTime::currentMSecsSinceEpoch();
+  const QString time = timeFor(now);
+  if (!m_pendingOut.isEmpty())
+    rest.append({now, QString::fromUtf8(m_pendingOut), false, time});
+  if (!m_pendingErr.isEmpty())
+    rest.append({now, QString::fromUtf8(m_pendingErr), true, time});
+  m_pendingOut.clear();
+  m_pendingErr.clear();
+  if (!rest.isEmpty())
+    appendLines(rest);
+
+  if (m_file.isOpen()) {
+    flushFile();
+    m_file.close();
+    emit sessionChanged();
+  }
+}
+
+void GameLog::appendLines(const QVector<Line> &lines) {
+  writeToFile(lines);
+
+  // Sólo caben las últimas m_maxLines del bloque
+  const int n = qMin(lines.size(), m_maxLines);
+  const int skip = lines.size() - n;
+
+  const int overflow = m_count + n - m_maxLines;
+  if (overflow > 0) {
+    beginRemoveRows(QModelIndex(), 0, overflow - 1);
+    m_head = (m_head + overflow) % m_maxLines;
+    m_count -= overflow;
+    endRemoveRows();
+  }
+
+  beginInsertRows(QModelIndex(), m_count, m_count + n - 1);
+  for (int i = 0; i < n; ++i)
+    m_lines[(m_head + m_count + i) % m_maxLines] = lines.at(skip + i);
+  m_count += n;
+  endInsertRows();
+  emit countChanged();
+}
+
+QString GameLog::formatLine(const Line &line) {
+  return QStringLiteral("[%1]%2 %3")
+      .arg(QDateTime::fromMSecsSinceEpoch(line.timestamp)
+               .toString("yyyy-MM-dd HH:mm:ss.zzz"),
+           line.isStderr ? QStringLiteral(" [stderr]") : QString(),
+           line.text);
+}
+
+void GameLog::writeToFile(const QVector<Line> &lines) {
+  if (!m_file.isOpen())
+    return;
+
+  // Un cliente verboso entrega muchos bloques pequeños por segundo: se
+  // acumulan y el archivo se escribe por tandas, no en cada lectura
+  for (const Line &line : lines) {
+    m_fileBuffer.append(formatLine(line).toUtf8());
+    m_fileBuffer.append('\n');
+  }
+  if (m_fileBuffer.size() >= kFlushBytes)
+    flushFile();
+  else if (!m_flushTimer->isActive())
+    m_flushTimer->start();
+}
+
+void GameLog::flushFile() {
+  m_flushTimer->stop();
+  if (m_fileBuffer.isEmpty() || !m_file.isOpen())
+    return;
+  m_file.write(m_fileBuffer);
+  m_file.flush();
+  m_fileBuffer.clear();
+
+  if (m_file.size() >= kMaxFileBytes)
+    rotateFile();
+}
+
+void GameLog::rotateFile() {
+  const QString base = m_file.fileName();
+  m_file.close();
+
+  QFile::remove(base + QStringLiteral(".%1").arg(kMaxRotations));
+  for (int i = kMaxRotations - 1; i >= 1; --i)
+    QFile::rename(base + QStringLiteral(".%1").arg(i),
+                  base + QStringLiteral(".%1").arg(i + 1));
+  QFile::rename(base, base + QStringLiteral(".1"));
+
+  m_file.setFileName(base);
+  if (!m_file.open(QIODevice::WriteOnly | QIODevice::Append))
+    qWarning() << "[GameLog] cannot reopen session log after rotation"
+               << base << m_file.errorString();
+}
+
+void GameLog::pruneSessions(const QString &logsDir) {
+  // Más recientes primero; las rotaciones (.log.N) van con su sesión
+  const QFileInfoList sessions =
+      QDir(logsDir).entryInfoList({QStringLiteral("game-*.log")}, QDir::Files,
+                                  QDir::Time);
+  for (int i = kKeepSessions - 1; i < sessions.size(); ++i) {
+    const QString path = sessions.at(i).absoluteFilePath();
+    QFile::remove(path);
+    for (int r = 1; r <= kMaxRotations; ++r)
+      QFile::remove(path + QStringLiteral(".%1").arg(r));
+  }
+}
+
+void GameLog::clear() {
+  beginResetModel();
+  m_head = 0;
+  m_count = 0;
+  endResetModel();
+  emit countChanged();
+}
+
+void GameLog::setMaxLines(int maxLines) {
+  maxLines = qBound(100, maxLines, 1000000);
+  if (m_maxLines == maxLines)
+    return;
+
+  // Conservar las líneas más recientes que quepan
+  beginResetModel();
+  const int keep = qMin(m_count, maxLines);
+  QVector<Line> resized(maxLines);
+  for (int i = 0; i < keep; ++i)
+    resized[i] = at(m_count - keep + i);
+  m_lines = resized;
+  m_maxLines = maxLines;
+  m_head = 0;
+  m_count = keep;
+  endResetModel();
+  emit maxLinesChanged();
+  emit countChanged();
+}
+
+QString GameLog::getLogs() const {
+  QString text;
+  for (int i = 0; i < m_count; ++i) {
+    text.append(formatLine(at(i)));
+    text.append('\n');
+  }
+  return text;
+}
+
+QByteArray GameLog::tail(int maxBytes) const {
+  QList<QByteArray> lines;
+  int total = 0;
+  for (int i = m_count - 1; i >= 0; --i) {
+    QByteArray line = formatLine(at(i)).toUtf8();
+    line.append('\n');
+    if (total + line.size() > maxBytes)
+      break;
+    total += line.size();
+    lines.prepend(line);
+  }
+  QByteArray out;
+  out.reserve(total);
+  for (const QByteArray &line : lines)
+    out.append(line);
+  return out;
+}
+
+void GameLog::copyToClipboard() const {
+  QClipboard *clipboard = QGuiApplication::clipboard();
+  if (clipboard)
+    clipboard->setText(getLogs());
+}
+
+void GameLog::saveLog(const QString &filePath) const {
+  QString path = QUrl(filePath).toLocalFile();
+  if (path.isEmpty())
+    path = filePath;
+
+  QFile file(path);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    qWarning() << "[GameLog] cannot write" << path << file.errorString();
+    return;
+  }
+  file.write(getLogs().toUtf8());
+}
@@ -0,0 +1,199 @@
+#include "../include/launchmetrics.h"
+#include "../include/logcategories.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSaveFile>
+
+#include <algorithm>
+
+namespace {
+
+const char *const kPhases[] = {"started", "firstOutput", "window"};
+
+// Percentil por rango más cercano sobre las muestras de una fase
+qint64 percentile(const QJsonArray &samples, double p) {
+  if (samples.isEmpty())
+    return -1;
+  QVector<qint64> sorted;
+  sorted.reserve(samples.size());
+  for (const QJsonValue &v : samples)
+    sorted.append(qint64(v.toDouble()));
+  std::sort(sorted.begin(), sorted.end());
+  const int rank = qBound(0, int(p * sorted.size() + 0.5) - 1,
+                          sorted.size() - 1);
+  return sorted.at(rank);
+}
+
+} // namespace
+
+LaunchMetrics::LaunchMetrics(QObject *parent)
+    : QObject(parent),
+      m_windowMarkers({"gamewindow", "window created", "eglmakecurrent"}) {}
+
+void LaunchMetrics::setStorePath(const QString &path) {
+  if (m_storePath == path)
+    return;
+  m_storePath = path;
+  load();
+}
+
+QString LaunchMetrics::windowMarker() const {
+  return QString::fromUtf8(m_windowMarkers.join('|'));
+}
+
+void LaunchMetrics::setWindowMarker(const QString &pattern) {
+  QByteArrayList markers;
+  for (const QByteArray &marker : pattern.toUtf8().toLower().split('|'))
+    if (!marker.isEmpty())
+      markers.append(marker);
+  if (markers.isEmpty()) {
+    qWarning() << "[LaunchMetrics] invalid window marker" << pattern;
+    return;
+  }
+  if (m_windowMarkers == markers)
+    return;
+  m_windowMarkers = markers;
+  emit windowMarkerChanged();
+}
+
+LaunchMetrics::Session LaunchMetrics::begin(const QString &versionName) const {
+  Session session;
+  session.version = versionName;
+  session.clock.start();
+  return session;
+}
+
+void LaunchMetrics::markStarted(Session &session) const {
+  if (!session.clock.isValid() || session.startedMs >= 0)
+    return;
+  session.startedMs = session.clock.elapsed();
+  qCDebug(lcGame) << "[LaunchMetrics]" << session.version
+                  << "process started after" << session.startedMs << "ms";
+}
+
+void LaunchMetrics::observeOutput(Session &session,
+                                  const QByteArray &chunk) const {
+  // Tras ver la ventana (o darla por perdida) no queda nada que medir
+  if (!session.clock.isValid() || session.windowMs >= 0 ||
+      session.windowMissing || chunk.isEmpty())
+    return;
+
+  const qint64 now = session.clock.elapsed();
+  if (session.firstOutputMs < 0 && chunk.contains('\n')) {
+    session.firstOutputMs = now;
+    qCDebug(lcGame) << "[LaunchMetrics]" << session.version
+                    << "first output after" << session.firstOutputMs << "ms";
+  }
+
+  // Un cliente que nunca escribe la marca no puede costar una búsqueda por
+  // bloque durante toda la sesión
+  session.scannedBytes += chunk.size();
+  if (now > kMaxScanMs || session.scannedBytes > kMaxScanBytes) {
+    session.windowMissing = true;
+    qCDebug(lcGame) << "[LaunchMetrics]" << session.version
+                    << "window marker not seen after" << now << "ms,"
+                    << session.scannedBytes << "bytes";
+    return;
+  }
+  const QByteArray lower = chunk.toLower();
+  for (const QByteArray &marker : m_windowMarkers) {
+    if (lower.contains(marker)) {
+      session.windowMs = now;
+      qCDebug(lcGame) << "[LaunchMetrics]" << session.version
+                      << "window after" << session.windowMs << "ms";
+      return;
+    }
+  }
+}
+
+void LaunchMetrics::finish(Session &session) {
+  if (!session.clock.isValid())
+    return;
+  session.clock.invalidate();
+  if (session.version.isEmpty() || session.startedMs < 0)
+    return;
+
+  QJsonObject entry = m_versions.value(session.version).toObject();
+  entry["launches"] = entry.value("launches").toInt() + 1;
+  if (session.windowMs < 0)
+    entry["windowMissing"] = entry.value("windowMissing").toInt() + 1;
+  m_versions[session.version] = entry;
+
+  record(session.version, "started", session.startedMs);
+  if (session.firstOutputMs >= 0)
+    record(session.version, "firstOutput", session.firstOutputMs);
+  if (session.windowMs >= 0)
+    record(session.version, "window", session.windowMs);
+
+  save();
+  emit summaryChanged();
+}
+
+void LaunchMetrics::record(const QString &version, const QString &phase,
+                           qint64 ms) {
+  QJsonObject entry = m_versions.value(version).toObject();
+  QJsonArray samples = entry.value(phase).toArray();
+  samples.append(double(ms));
+  while (samples.size() > kMaxSamples)
+    samples.removeFirst();
+  entry[phase] = samples;
+  m_versions[version] = entry;
+}
+
+QVariantList LaunchMetrics::summary() const {
+  QVariantList list;
+  for (auto it = m_versions.constBegin(); it != m_versions.constEnd(); ++it) {
+    const QJsonObject entry = it.value().toObject();
+    QVariantMap row;
+    row["version"] = it.key();
+    row["launches"] = entry.value("launches").toInt();
+    row["windowMissing"] = entry.value("windowMissing").toInt();
+    for (const char *phase : kPhases) {
+      const QJsonArray samples = entry.value(phase).toArray();
+      row[QString(phase) + "P50"] = percentile(samples, 0.50);
+      row[QString(phase) + "P95"] = percentile(samples, 0.95);
+    }
+    list.append(row);
+  }
+  return list;
+}
+
+void LaunchMetrics::reset(const QString &versionName) {
+  if (versionName.isEmpty())
+    m_versions = QJsonObject();
+  else
+    m_versions.remove(versionName);
+  save();
+  emit summaryChanged();
+}
+
+void LaunchMetrics::load() {
+  m_versions = QJsonObject();
+  QFile f(m_storePath);
+  if (f.open(QIODevice::ReadOnly))
+    m_versions = QJsonDocument::fromJson(f.readAll())
+                     .object()
+                     .value("versions")
+                     .toObject();
+  emit summaryChanged();
+}
+
+void LaunchMetrics::save() const {
+  if (m_storePath.isEmpty())
+    return;
+  QSaveFile f(m_storePath);
+  if (!f.open(QIODevice::WriteOnly)) {
+    qWarning() << "[LaunchMetrics] cannot write" << m_storePath
+               << f.errorString();
+    return;
+  }
+  QJsonObject root;
+  root["versions"] = m_versions;
+  f.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+  if (!f.commit())
+    qWarning() << "[LaunchMetrics] cannot commit" << m_storePath
+               << f.errorString();
+}
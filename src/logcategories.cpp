@@ -0,0 +1,62 @@
+#include "../include/logcategories.h"
+
+#include <QSettings>
+#include <QStringList>
+
+Q_LOGGING_CATEGORY(lcPaths, "launcher.paths", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcVersions, "launcher.versions", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcInstall, "launcher.install", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcGame, "launcher.game", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcWorlds, "launcher.worlds", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcProfiles, "launcher.profiles", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcUi, "launcher.ui", QtInfoMsg)
+
+namespace {
+const char *const kSettingsKey = "logging/debugCategories";
+
+QSettings *settings() {
+  // Mismo archivo que ProfileManager
+  static QSettings s(QSettings::IniFormat, QSettings::UserScope,
+                     "org.lazheart", "minecraft-launcher");
+  return &s;
+}
+} // namespace
+
+namespace LogCategories {
+
+QList<QLoggingCategory *> all() {
+  return {&lcPaths(),  &lcVersions(), &lcInstall(), &lcGame(),
+          &lcWorlds(), &lcProfiles(), &lcUi()};
+}
+
+QLoggingCategory *find(const QString &name) {
+  for (QLoggingCategory *category : all())
+    if (name == QLatin1String(category->categoryName()))
+      return category;
+  return nullptr;
+}
+
+bool setDebugEnabled(const QString &name, bool enabled) {
+  QLoggingCategory *category = find(name);
+  if (!category)
+    return false;
+  category->setEnabled(QtDebugMsg, enabled);
+
+  QStringList enabledNames;
+  for (QLoggingCategory *c : all())
+    if (c->isDebugEnabled())
+      enabledNames << QString::fromLatin1(c->categoryName());
+  settings()->setValue(kSettingsKey, enabledNames);
+  return true;
+}
+
+void restore() {
+  const QStringList enabledNames =
+      settings()->value(kSettingsKey).toStringList();
+  for (QLoggingCategory *category : all())
+    category->setEnabled(
+        QtDebugMsg,
+        enabledNames.contains(QString::fromLatin1(category->categoryName())));
+}
+
+} // namespace LogCategories
@@ -0,0 +1,285 @@
+#include "../include/logexporter.h"
+#include "../include/logfilewriter.h"
+#include "../include/processpriority.h"
+#include "../include/progressreporter.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QSaveFile>
+#include <QSet>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <zlib.h>
+
+namespace {
+
+// Destino de la exportación: QSaveFile, con un deflate en formato gzip
+// delante si se pidió compresión
+class ExportSink
+{
+public:
+    ExportSink(const QString &path, bool gzip) : m_file(path), m_gzip(gzip) {}
+    ~ExportSink()
+    {
+        if (m_deflating)
+            deflateEnd(&m_zs);
+    }
+
+    bool open()
+    {
+        if (!m_file.open(QIODevice::WriteOnly))
+            return fail(m_file.errorString());
+        if (m_gzip) {
+            m_out.resize(LogExporter::kChunkBytes);
+            // 15 + 16: cabecera gzip en lugar de zlib
+            if (deflateInit2(&m_zs, 6, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+                return fail(QStringLiteral("cannot initialize gzip"));
+            m_deflating = true;
+        }
+        return true;
+    }
+
+    bool write(const char *data, qint64 size)
+    {
+        if (!m_gzip)
+            return m_file.write(data, size) == size || fail(m_file.errorString());
+        m_zs.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+        m_zs.avail_in = uInt(size);
+        return deflateOut(Z_NO_FLUSH);
+    }
+
+    bool commit()
+    {
+        if (m_gzip && !deflateOut(Z_FINISH))
+            return false;
+        return m_file.commit() || fail(m_file.errorString());
+    }
+
+    QString error() const { return m_error; }
+
+private:
+    bool deflateOut(int flush)
+    {
+        do {
+            m_zs.next_out = reinterpret_cast<Bytef *>(m_out.data());
+            m_zs.avail_out = uInt(m_out.size());
+            if (deflate(&m_zs, flush) == Z_STREAM_ERROR)
+                return fail(QStringLiteral("gzip stream error"));
+            const qint64 n = m_out.size() - qint64(m_zs.avail_out);
+            if (n > 0 && m_file.write(m_out.constData(), n) != n)
+                return fail(m_file.errorString());
+        } while (m_zs.avail_out == 0);
+        return true;
+    }
+
+    bool fail(const QString &error)
+    {
+        if (m_error.isEmpty())
+            m_error = error;
+        return false;
+    }
+
+    QSaveFile m_file;
+    bool m_gzip = false;
+    bool m_deflating = false;
+    z_stream m_zs = {};
+    QByteArray m_out;
+    QString m_error;
+};
+
+} // namespace
+
+LogExporter::LogExporter(QObject *parent)
+    : QObject(parent)
+{
+}
+
+LogExporter::~LogExporter()
+{
+    // El trabajo puede estar leyendo del LogFileWriter de LogHandler, que se
+    // destruye justo después
+    if (m_cancel)
+        m_cancel->store(true);
+    m_future.waitForFinished();
+}
+
+QStringList LogExporter::historyFiles(const QString &dir)
+{
+    if (dir.isEmpty())
+        return {};
+    // Por nombre: launcher-YYYYMMDD-HHmmss.log (rotado por tamaño) queda
+    // antes que launcher-YYYYMMDD.log, que es donde siguió escribiendo
+    const QStringList names = QDir(dir).entryList(
+        {QStringLiteral("launcher-*.log"), QStringLiteral("launcher-*.log.gz")}, QDir::Files,
+        QDir::Name);
+    const QSet<QString> present(names.begin(), names.end());
+
+    QStringList files;
+    for (const QString &name : names) {
+        if (name.endsWith(QLatin1String(".gz")) && present.contains(name.chopped(3)))
+            continue;
+        files.append(QDir(dir).filePath(name));
+    }
+    return files;
+}
+
+void LogExporter::setProgress(double progress)
+{
+    if (qFuzzyCompare(m_progress + 1.0, progress + 1.0))
+        return;
+    m_progress = progress;
+    emit progressChanged();
+}
+
+bool LogExporter::start(Job job)
+{
+    if (m_busy)
+        return false;
+
+    m_busy = true;
+    emit busyChanged();
+    setProgress(0.0);
+
+    auto cancelled = std::make_shared<std::atomic_bool>(false);
+    m_cancel = cancelled;
+
+    const auto progressFn = throttledProgress(this, &LogExporter::setProgress);
+
+    const QString path = job.path;
+    auto *watcher = new QFutureWatcher<Result>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, path]() {
+        const Result result = watcher->result();
+        watcher->deleteLater();
+        m_cancel.reset();
+        setProgress(1.0);
+        m_busy = false;
+        emit busyChanged();
+        if (!result.ok && !result.cancelled)
+            qWarning() << "[LogExporter] export to" << path << "failed:" << result.error;
+        else if (result.ok && !result.error.isEmpty())
+            qWarning() << "[LogExporter] export to" << path << ":" << result.error;
+        emit finished(path, result.ok, result.cancelled ? QStringLiteral("cancelled") : result.error);
+    });
+    m_future = QtConcurrent::run([job = std::move(job), progressFn, cancelled]() {
+        return run(job, progressFn, cancelled);
+    });
+    watcher->setFuture(m_future);
+    return true;
+}
+
+void LogExporter::cancel()
+{
+    if (m_cancel)
+        m_cancel->store(true);
+}
+
+LogExporter::Result LogExporter::run(const Job &job,
+                                     const std::function<void(double)> &progressFn,
+                                     const std::shared_ptr<std::atomic_bool> &cancelled)
+{
+    ProcessPriority::WorkerScope priority;
+    Result result;
+
+    ExportSink sink(job.path, job.gzip);
+    if (!sink.open()) {
+        result.error = sink.error();
+        return result;
+    }
+
+    if (!job.files.isEmpty()) {
+        // Lo que aún esté en la cola del escritor también debe salir
+        if (job.writer)
+            job.writer->flush(kFlushTimeoutMs);
+
+        QVector<qint64> sizes;
+        qint64 total = 0;
+        for (const QString &file : job.files) {
+            sizes.append(QFileInfo(file).size());
+            total += sizes.last();
+        }
+
+        // gzread lee igual los .gz y los archivos sin comprimir
+        QByteArray buffer(kChunkBytes, Qt::Uninitialized);
+        qint64 done = 0;
+        QStringList skipped;
+        for (int f = 0; f < job.files.size(); ++f) {
+            const QString &file = job.files.at(f);
+            gzFile in = gzopen(QFile::encodeName(file).constData(), "rb");
+            // El escritor pudo comprimirlo después de historyFiles()
+            if (!in && file.endsWith(QLatin1String(".log")))
+                in = gzopen(QFile::encodeName(file + QLatin1String(".gz")).constData(), "rb");
+            if (!in) {
+                // Borrado por la limpieza de archivos viejos
+                skipped.append(QFileInfo(file).fileName());
+                done += sizes.at(f);
+                continue;
+            }
+            int n;
+            while ((n = gzread(in, buffer.data(), unsigned(buffer.size()))) > 0) {
+                if (cancelled->load() || !sink.write(buffer.constData(), n)) {
+                    gzclose(in);
+                    result.cancelled = cancelled->load();
+                    result.error = sink.error();
+                    return result;
+                }
+                // Posición en el archivo de entrada (comprimido o no)
+                if (total > 0)
+                    progressFn(double(done + qMin<qint64>(gzoffset(in), sizes.at(f))) / total);
+            }
+            gzclose(in);
+            done += sizes.at(f);
+        }
+        if (!skipped.isEmpty())
+            result.error = QStringLiteral("skipped missing files: ") +
+                           skipped.join(QStringLiteral(", "));
+    } else {
+        // Mismo formato que la consola: "[fecha] [NIVEL] mensaje"
+        QByteArray out;
+        out.reserve(kChunkBytes + 4096);
+        qint64 second = -1;
+        QByteArray time;
+        QByteArray levels[5];
+        for (int l = 0; l < 5; ++l)
+            levels[l] = LogHandler::levelName(static_cast<LogLevel>(l)).toLatin1();
+        const int total = job.messages.size();
+        for (int i = 0; i < total; ++i) {
+            const LogMessage &msg = job.messages.at(i);
+            if (msg.timestamp / 1000 != second) {
+                second = msg.timestamp / 1000;
+                time = QDateTime::fromMSecsSinceEpoch(second * 1000)
+                           .toString(QStringLiteral("yyyy-MM-dd HH:mm:ss"))
+                           .toUtf8();
+            }
+            out += '[';
+            out += time;
+            out += "] [";
+            out += levels[static_cast<int>(msg.level)];
+            out += "] ";
+            out += msg.message.toUtf8();
+            out += '\n';
+
+            if (out.size() >= kChunkBytes || i == total - 1) {
+                if (cancelled->load() || !sink.write(out.constData(), out.size())) {
+                    result.cancelled = cancelled->load();
+                    result.error = sink.error();
+                    return result;
+                }
+                out.resize(0); // conserva la capacidad reservada
+                progressFn(double(i + 1) / total);
+            }
+        }
+    }
+
+    if (cancelled->load()) {
+        result.cancelled = true;
+        return result;
+    }
+    result.ok = sink.commit();
+    if (!result.ok)
+        result.error = sink.error();
+    return result;
+}
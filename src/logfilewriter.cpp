@@ -0,0 +1,302 @@
+#include "../include/logfilewriter.h"
+
+#include <QDate>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+
+#include <chrono>
+#include <cstdio>
+
+#include <zlib.h>
+
+namespace {
+
+const char *levelName(QtMsgType type)
+{
+    switch (type) {
+    case QtDebugMsg: return "DEBUG";
+    case QtInfoMsg: return "INFO";
+    case QtWarningMsg: return "WARNING";
+    case QtCriticalMsg: return "CRITICAL";
+    case QtFatalMsg: return "FATAL";
+    }
+    return "UNKNOWN";
+}
+
+qint64 localDay(qint64 timestamp)
+{
+    return QDateTime::fromMSecsSinceEpoch(timestamp).date().toJulianDay();
+}
+
+// Este archivo no puede usar qWarning: volvería a entrar en el manejador de
+// mensajes y, de ahí, en la cola del propio escritor
+void report(const QString &what)
+{
+    fprintf(stderr, "[LogFileWriter] %s\n", what.toLocal8Bit().constData());
+}
+
+} // namespace
+
+LogFileWriter::LogFileWriter()
+{
+    m_thread = std::thread([this]() { run(); });
+}
+
+LogFileWriter::~LogFileWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_one();
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+void LogFileWriter::append(qint64 timestamp, QtMsgType type, const QString &message)
+{
+    m_queue.push({timestamp, type, message});
+    const bool urgent = type == QtWarningMsg || type == QtCriticalMsg || type == QtFatalMsg;
+    if (urgent) {
+        // Como en ConsoleMirror::write: m_wake bajo el mutex, o el hilo vería
+        // el predicado falso y volvería a dormir hasta el intervalo
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_wake = true;
+        }
+        m_pending.fetch_add(1, std::memory_order_relaxed);
+        m_cv.notify_one();
+    } else if (m_pending.fetch_add(1, std::memory_order_relaxed) + 1 == kWakeBatch) {
+        // Sin tomar el mutex: una notificación perdida sólo retrasa la
+        // escritura hasta el siguiente intervalo
+        m_cv.notify_one();
+    }
+    // Como ConsoleMirror::print: tras un fatal no hay "más tarde". El hilo
+    // escritor no emite mensajes, pero si el fatal viniera de él mismo
+    // esperarle sería esperar para siempre.
+    if (type == QtFatalMsg && std::this_thread::get_id() != m_thread.get_id())
+        flush(kFatalFlushTimeoutMs);
+}
+
+void LogFileWriter::setDirectory(const QString &dir)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_dir = dir;
+        m_wake = true;
+    }
+    m_cv.notify_one();
+}
+
+QString LogFileWriter::currentFile() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_currentPath;
+}
+
+QString LogFileWriter::directory() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_dir;
+}
+
+bool LogFileWriter::flush(int timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const quint64 ticket = ++m_flushRequested;
+    m_wake = true;
+    m_cv.notify_one();
+    return m_flushedCv.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+                                [this, ticket]() { return m_flushed >= ticket || m_stop; });
+}
+
+void LogFileWriter::run()
+{
+    QVector<Entry> batch;
+    for (;;) {
+        bool stop;
+        quint64 flushTicket;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait_for(lock, std::chrono::milliseconds(kFlushIntervalMs), [this]() {
+                return m_stop || m_wake ||
+                       m_pending.load(std::memory_order_relaxed) >= kWakeBatch;
+            });
+            m_wake = false;
+            stop = m_stop;
+            flushTicket = m_flushRequested;
+        }
+
+        m_pending.store(0, std::memory_order_relaxed);
+        Entry entry;
+        while (m_queue.tryPop(entry))
+            batch.append(std::move(entry));
+        writeBatch(batch);
+        batch.clear();
+
+        if (flushTicket != m_flushed) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_flushed = flushTicket;
+            }
+            m_flushedCv.notify_all();
+        }
+
+        if (stop)
+            break;
+    }
+
+    if (m_file.isOpen())
+        m_file.close();
+}
+
+void LogFileWriter::writeBatch(QVector<Entry> &batch)
+{
+    QString dir;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        dir = m_dir;
+    }
+
+    if (dir.isEmpty()) {
+        // Aún no se sabe dónde escribir: retener lo más reciente
+        m_held += batch;
+        if (m_held.size() > kMaxHeldLines)
+            m_held.remove(0, m_held.size() - kMaxHeldLines);
+        return;
+    }
+    if (dir != m_openDir) {
+        if (m_file.isOpen())
+            m_file.close();
+        m_openDir = dir;
+        m_fileDay = -1;
+    }
+    if (!m_held.isEmpty()) {
+        batch = m_held + batch;
+        m_held.clear();
+    }
+    if (batch.isEmpty())
+        return;
+
+    QByteArray out;
+    for (const Entry &e : batch) {
+        if (localDay(e.timestamp) != m_fileDay || !m_file.isOpen()) {
+            if (!out.isEmpty()) {
+                m_file.write(out);
+                out.clear();
+            }
+            openFor(e.timestamp);
+        }
+        out += '[';
+        out += QDateTime::fromMSecsSinceEpoch(e.timestamp)
+                   .toString(QStringLiteral("yyyy-MM-dd HH:mm:ss.zzz"))
+                   .toUtf8();
+        out += "] [";
+        out += levelName(e.type);
+        out += "] ";
+        out += e.message.toUtf8();
+        out += '\n';
+    }
+    if (m_file.isOpen()) {
+        m_file.write(out);
+        m_file.flush();
+        if (m_file.size() >= kMaxFileBytes)
+            rotateBySize();
+    }
+}
+
+void LogFileWriter::openFor(qint64 timestamp)
+{
+    QString previous;
+    if (m_file.isOpen()) {
+        previous = m_file.fileName();
+        m_file.close();
+    }
+
+    QDir().mkpath(m_openDir);
+    const QDate day = QDateTime::fromMSecsSinceEpoch(timestamp).date();
+    m_fileDay = day.toJulianDay();
+    m_file.setFileName(QDir(m_openDir).filePath(
+        QStringLiteral("launcher-%1.log").arg(day.toString(QStringLiteral("yyyyMMdd")))));
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Append))
+        report(QStringLiteral("cannot open %1: %2").arg(m_file.fileName(), m_file.errorString()));
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_currentPath = m_file.isOpen() ? m_file.fileName() : QString();
+    }
+
+    // El archivo del día anterior ya no se va a tocar
+    if (!previous.isEmpty() && previous != m_file.fileName())
+        finishFile(previous);
+    pruneOld();
+}
+
+void LogFileWriter::rotateBySize()
+{
+    // launcher-YYYYMMDD.log -> launcher-YYYYMMDD-HHmmss.log, y se sigue en
+    // un archivo nuevo con el nombre del día
+    const QString path = m_file.fileName();
+    m_file.close();
+    const QFileInfo fi(path);
+    const QString rotated = fi.absoluteDir().filePath(
+        QStringLiteral("%1-%2.log")
+            .arg(fi.completeBaseName(),
+                 QDateTime::currentDateTime().toString(QStringLiteral("HHmmss"))));
+    if (QFile::rename(path, rotated))
+        finishFile(rotated);
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Append))
+        report(QStringLiteral("cannot reopen %1: %2").arg(path, m_file.errorString()));
+}
+
+void LogFileWriter::finishFile(const QString &path)
+{
+    if (m_compress.load() && gzipFile(path))
+        QFile::remove(path);
+}
+
+void LogFileWriter::pruneOld()
+{
+    const QDateTime cutoff = QDateTime::currentDateTime().addDays(-kKeepDays);
+    const QFileInfoList files = QDir(m_openDir).entryInfoList(
+        {QStringLiteral("launcher-*.log"), QStringLiteral("launcher-*.log.gz")}, QDir::Files);
+    for (const QFileInfo &fi : files) {
+        if (fi.absoluteFilePath() == m_file.fileName())
+            continue;
+        if (fi.lastModified() < cutoff) {
+            QFile::remove(fi.absoluteFilePath());
+        } else if (fi.suffix() == QLatin1String("log")) {
+            // Archivos sin comprimir de sesiones anteriores
+            finishFile(fi.absoluteFilePath());
+        }
+    }
+}
+
+bool LogFileWriter::gzipFile(const QString &path)
+{
+    QFile in(path);
+    if (!in.open(QIODevice::ReadOnly))
+        return false;
+    const QString gzPath = path + QStringLiteral(".gz");
+    gzFile out = gzopen(QFile::encodeName(gzPath).constData(), "wb6");
+    if (!out) {
+        report(QStringLiteral("cannot create %1").arg(gzPath));
+        return false;
+    }
+    bool ok = true;
+    while (ok && !in.atEnd()) {
+        const QByteArray chunk = in.read(256 * 1024);
+        if (chunk.isEmpty())
+            break;
+        ok = gzwrite(out, chunk.constData(), unsigned(chunk.size())) == chunk.size();
+    }
+    ok = gzclose(out) == Z_OK && ok;
+    if (!ok) {
+        report(QStringLiteral("failed to compress %1").arg(path));
+        QFile::remove(gzPath);
+    }
+    return ok;
+}
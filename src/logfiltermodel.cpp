@@ -0,0 +1,273 @@
+#include "../include/logfiltermodel.h"
+#include "../include/loghandler.h"
+
+#include <QDateTime>
+#include <QTimer>
+
+#include <algorithm>
+#include <vector>
+
+LogFilterModel::LogFilterModel(LogHandler *source, QObject *parent)
+    : QAbstractListModel(parent), m_source(source)
+{
+    m_textTimer = new QTimer(this);
+    m_textTimer->setSingleShot(true);
+    m_textTimer->setInterval(kTextDebounceMs);
+    connect(m_textTimer, &QTimer::timeout, this, &LogFilterModel::rebuild);
+
+    m_windowTimer = new QTimer(this);
+    m_windowTimer->setInterval(kWindowTickMs);
+    connect(m_windowTimer, &QTimer::timeout, this, &LogFilterModel::expireWindow);
+
+    if (m_source) {
+        connect(m_source, &QAbstractItemModel::rowsInserted, this,
+                &LogFilterModel::sourceRowsInserted);
+        connect(m_source, &QAbstractItemModel::rowsAboutToBeRemoved, this,
+                &LogFilterModel::sourceRowsAboutToBeRemoved);
+        connect(m_source, &QAbstractItemModel::modelReset, this, &LogFilterModel::rebuild);
+    }
+    rebuild();
+}
+
+int LogFilterModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return 0;
+    return count();
+}
+
+QVariant LogFilterModel::data(const QModelIndex &index, int role) const
+{
+    if (!m_source || !index.isValid() || index.row() < 0 || index.row() >= count())
+        return QVariant();
+    const qint64 sourceRow = m_rows[size_t(index.row())] - m_source->firstSeq();
+    if (sourceRow < 0 || sourceRow >= m_source->rowCount())
+        return QVariant();
+    return m_source->data(m_source->index(int(sourceRow)), role);
+}
+
+QHash<int, QByteArray> LogFilterModel::roleNames() const
+{
+    return m_source ? m_source->roleNames() : QHash<int, QByteArray>();
+}
+
+bool LogFilterModel::isActive() const
+{
+    return m_minLevel > 0 || !m_component.isEmpty() || !m_text.isEmpty() ||
+           m_since > 0 || m_until > 0 || m_window > 0;
+}
+
+void LogFilterModel::refilter()
+{
+    rebuild();
+    emit filterChanged();
+}
+
+void LogFilterModel::setMinLevel(int level)
+{
+    level = qBound(0, level, 3);
+    if (m_minLevel == level)
+        return;
+    m_minLevel = level;
+    refilter();
+}
+
+void LogFilterModel::setComponent(const QString &component)
+{
+    if (m_component == component)
+        return;
+    m_component = component;
+    refilter();
+}
+
+void LogFilterModel::setText(const QString &text)
+{
+    if (m_text == text)
+        return;
+    m_text = text;
+    // La expresión se compila una vez por cambio, no por fila; el filtrado
+    // espera a que se deje de escribir
+    m_regex = QRegularExpression(text, QRegularExpression::CaseInsensitiveOption);
+    emit filterChanged();
+    m_textTimer->start();
+}
+
+void LogFilterModel::setUseRegex(bool useRegex)
+{
+    if (m_useRegex == useRegex)
+        return;
+    m_useRegex = useRegex;
+    refilter();
+}
+
+void LogFilterModel::setSince(qint64 since)
+{
+    since = qMax<qint64>(0, since);
+    if (m_since == since)
+        return;
+    m_since = since;
+    refilter();
+}
+
+void LogFilterModel::setUntil(qint64 until)
+{
+    until = qMax<qint64>(0, until);
+    if (m_until == until)
+        return;
+    m_until = until;
+    refilter();
+}
+
+void LogFilterModel::setWindow(qint64 window)
+{
+    window = qMax<qint64>(0, window);
+    if (m_window == window)
+        return;
+    m_window = window;
+    if (m_window > 0)
+        m_windowTimer->start();
+    else
+        m_windowTimer->stop();
+    refilter();
+}
+
+void LogFilterModel::reset()
+{
+    m_minLevel = 0;
+    m_component.clear();
+    m_text.clear();
+    m_regex = QRegularExpression();
+    m_useRegex = false;
+    m_since = 0;
+    m_until = 0;
+    m_window = 0;
+    m_windowTimer->stop();
+    refilter();
+}
+
+qint64 LogFilterModel::windowCutoff() const
+{
+    return m_window > 0 ? QDateTime::currentMSecsSinceEpoch() - m_window : 0;
+}
+
+bool LogFilterModel::accepts(const LogMessage &msg, qint64 cutoff) const
+{
+    // Los criterios baratos primero; el texto al final
+    if (static_cast<int>(msg.level) < m_minLevel)
+        return false;
+    if (!m_component.isEmpty() && msg.component != m_component)
+        return false;
+    if ((m_since > 0 && msg.timestamp < m_since) ||
+        (m_until > 0 && msg.timestamp > m_until) ||
+        (cutoff > 0 && msg.timestamp < cutoff))
+        return false;
+    if (m_text.isEmpty())
+        return true;
+    if (m_useRegex)
+        return m_regex.isValid() && m_regex.match(msg.message).hasMatch();
+    return msg.message.contains(m_text, Qt::CaseInsensitive);
+}
+
+void LogFilterModel::rebuild()
+{
+    m_textTimer->stop();
+    beginResetModel();
+    m_rows.clear();
+    if (m_source) {
+        const qint64 first = m_source->firstSeq();
+        const qint64 cutoff = windowCutoff();
+        auto consider = [&](qint64 seq) {
+            if (accepts(m_source->messageAt(int(seq - first)), cutoff))
+                m_rows.push_back(seq);
+        };
+
+        // Candidatas: las del componente o las de los niveles admitidos,
+        // según el índice que sea más selectivo de los disponibles
+        const std::deque<qint64> *componentRows =
+            m_component.isEmpty() ? nullptr : m_source->rowsForComponent(m_component);
+        if (componentRows) {
+            for (qint64 seq : *componentRows)
+                consider(seq);
+        } else if (m_component.isEmpty() && m_minLevel > 0) {
+            std::vector<qint64> candidates;
+            for (int level = m_minLevel; level < LogHandler::kLevelCount; ++level) {
+                const std::deque<qint64> &rows =
+                    m_source->rowsForLevel(static_cast<LogLevel>(level));
+                const size_t mid = candidates.size();
+                candidates.insert(candidates.end(), rows.begin(), rows.end());
+                std::inplace_merge(candidates.begin(), candidates.begin() + mid,
+                                   candidates.end());
+            }
+            for (qint64 seq : candidates)
+                consider(seq);
+        } else {
+            // Sin índice útil (o componente fuera del pool): todas las filas
+            for (int row = 0; row < m_source->rowCount(); ++row)
+                consider(first + row);
+        }
+    }
+    endResetModel();
+    emit countChanged();
+}
+
+void LogFilterModel::sourceRowsInserted(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid())
+        return;
+    // LogHandler sólo añade al final: las secuencias nuevas van detrás
+    const qint64 base = m_source->firstSeq();
+    const qint64 cutoff = windowCutoff();
+    std::vector<qint64> accepted;
+    for (int row = first; row <= last; ++row)
+        if (accepts(m_source->messageAt(row), cutoff))
+            accepted.push_back(base + row);
+    if (accepted.empty())
+        return;
+
+    const int start = count();
+    beginInsertRows(QModelIndex(), start, start + int(accepted.size()) - 1);
+    m_rows.insert(m_rows.end(), accepted.begin(), accepted.end());
+    endInsertRows();
+    emit countChanged();
+}
+
+void LogFilterModel::sourceRowsAboutToBeRemoved(const QModelIndex &parent, int first,
+                                                int last)
+{
+    if (parent.isValid())
+        return;
+    // LogHandler sólo descarta las filas más antiguas, así que las demás
+    // conservan su secuencia
+    const qint64 base = m_source->firstSeq();
+    const auto from = std::lower_bound(m_rows.begin(), m_rows.end(), base + first);
+    const auto to = std::upper_bound(from, m_rows.end(), base + last);
+    if (from == to)
+        return;
+
+    const int row = int(from - m_rows.begin());
+    beginRemoveRows(QModelIndex(), row, row + int(to - from) - 1);
+    m_rows.erase(from, to);
+    endRemoveRows();
+    emit countChanged();
+}
+
+void LogFilterModel::expireWindow()
+{
+    if (!m_source || m_window <= 0)
+        return;
+    // Las secuencias van en orden de llegada, así que las que salen de la
+    // ventana están al principio
+    const qint64 first = m_source->firstSeq();
+    const qint64 cutoff = windowCutoff();
+    int expired = 0;
+    while (expired < count() &&
+           m_source->messageAt(int(m_rows[size_t(expired)] - first)).timestamp < cutoff)
+        ++expired;
+    if (expired == 0)
+        return;
+
+    beginRemoveRows(QModelIndex(), 0, expired - 1);
+    m_rows.erase(m_rows.begin(), m_rows.begin() + expired);
+    endRemoveRows();
+    emit countChanged();
+}
@@ -1,20 +1,60 @@
 #include "../include/loghandler.h"
-#include <QFile>
-#include <QTextStream>
+#include "../include/consolemirror.h"
+#include "../include/logcategories.h"
+#include "../include/logexporter.h"
+#include "../include/logfilewriter.h"
 #include <QDir>
 #include <QGuiApplication>
 #include <QClipboard>
+#include <QDateTime>
 #include <QMetaObject>
+#include <QSettings>
+#include <QTimer>
 #include <QUrl>
 
 LogHandler* LogHandler::m_instance = nullptr;
 
 LogHandler::LogHandler(QObject *parent)
-    : QAbstractListModel(parent)
+    : QAbstractListModel(parent), m_fileWriter(new LogFileWriter)
 {
+    m_drainTimer = new QTimer(this);
+    m_drainTimer->setSingleShot(true);
+    m_drainTimer->setInterval(kDrainIntervalMs);
+    connect(m_drainTimer, &QTimer::timeout, this, &LogHandler::drainQueue);
+    m_exporter = new LogExporter(this);
+    m_messages.resize(kInitialCapacity);
+    QSettings settings(QSettings::IniFormat, QSettings::UserScope,
+                       "org.lazheart", "minecraft-launcher");
+    const int budgetMb = settings.value("logging/memoryBudgetMb", kDefaultBudgetMb).toInt();
+    m_memoryBudget = qint64(qBound(kMinBudgetMb, budgetMb, kMaxBudgetMb)) * 1024 * 1024;
+    m_fileWriter->setCompressRotated(settings.value("logging/compressRotated", true).toBool());
     m_instance = this;
 }
 
+LogHandler::~LogHandler()
+{
+    // Antes de destruir m_fileWriter (que vacía su cola al terminar)
+    if (m_instance == this)
+        m_instance = nullptr;
+    // Espera a una exportación en curso, que puede estar usando m_fileWriter
+    delete m_exporter;
+}
+
+void LogHandler::setLogDirectory(const QString &dir)
+{
+    m_fileWriter->setDirectory(dir);
+}
+
+QString LogHandler::logFile() const
+{
+    return m_fileWriter->currentFile();
+}
+
+QObject *LogHandler::exporter() const
+{
+    return m_exporter;
+}
+
 LogHandler* LogHandler::instance()
 {
     return m_instance;
@@ -24,37 +64,92 @@ int LogHandler::rowCount(const QModelIndex &parent) const
 {
     if (parent.isValid())
         return 0;
-    return m_messages.count();
+    return m_count;
+}
+
+const LogMessage &LogHandler::at(int row) const
+{
+    return m_messages[(m_head + row) % m_messages.size()];
 }
 
 QVariant LogHandler::data(const QModelIndex &index, int role) const
 {
-    if (!index.isValid() || index.row() < 0 || index.row() >= m_messages.count())
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_count)
         return QVariant();
 
-    const LogMessage &msg = m_messages[index.row()];
+    const LogMessage &msg = at(index.row());
 
+    // Todas las cadenas devueltas son compartidas: el QVariant sólo sube el
+    // contador de referencias, sin formatear ni reservar memoria
     switch (role) {
     case TimeRole:
-        return msg.timestamp.toString("yyyy-MM-dd HH:mm:ss");
+        return timeString(msg.timestamp);
     case TypeRole:
-        switch(msg.type) {
-            case QtDebugMsg: return "DEBUG";
-            case QtInfoMsg: return "INFO";
-            case QtWarningMsg: return "WARNING";
-            case QtCriticalMsg: return "CRITICAL";
-            case QtFatalMsg: return "FATAL";
-            default: return "UNKNOWN";
-        }
+        return levelName(msg.level);
     case MessageRole:
         return msg.message;
     case ColorRole:
-        return msg.color;
+        return levelColor(msg.level);
+    case ComponentRole:
+        return msg.component;
+    case TimestampMsRole:
+        return msg.timestamp;
     default:
         return QVariant();
     }
 }
 
+LogLevel LogHandler::levelFor(QtMsgType type)
+{
+    switch (type) {
+    case QtDebugMsg: return LogLevel::Debug;
+    case QtInfoMsg: return LogLevel::Info;
+    case QtWarningMsg: return LogLevel::Warning;
+    case QtCriticalMsg: return LogLevel::Critical;
+    case QtFatalMsg: return LogLevel::Fatal;
+    }
+    return LogLevel::Debug;
+}
+
+const QString &LogHandler::levelName(LogLevel level)
+{
+    static const QString names[] = {
+        QStringLiteral("DEBUG"), QStringLiteral("INFO"), QStringLiteral("WARNING"),
+        QStringLiteral("CRITICAL"), QStringLiteral("FATAL")};
+    return names[static_cast<int>(level)];
+}
+
+const QString &LogHandler::levelColor(LogLevel level)
+{
+    static const QString colors[] = {
+        QStringLiteral("#b0b0b0"), // Gray
+        QStringLiteral("#ffffff"), // White
+        QStringLiteral("#ffcc00"), // Yellow
+        QStringLiteral("#ff5252"), // Red
+        QStringLiteral("#ff5252")};
+    return colors[static_cast<int>(level)];
+}
+
+const QString &LogHandler::timeString(qint64 timestamp) const
+{
+    const qint64 second = timestamp / 1000;
+    auto it = m_timeCache.constFind(second);
+    if (it != m_timeCache.constEnd())
+        return *it;
+    // Se vacía entera al llenarse: las filas visibles suelen caer en pocos
+    // segundos y vuelven a entrar enseguida
+    if (m_timeCache.size() >= kTimeCacheSize)
+        m_timeCache.clear();
+    return *m_timeCache.insert(
+        second, QDateTime::fromMSecsSinceEpoch(second * 1000).toString("yyyy-MM-dd HH:mm:ss"));
+}
+
+const std::deque<qint64> *LogHandler::rowsForComponent(const QString &component) const
+{
+    auto it = m_componentRows.constFind(component);
+    return it != m_componentRows.constEnd() ? &*it : nullptr;
+}
+
 QHash<int, QByteArray> LogHandler::roleNames() const
 {
     QHash<int, QByteArray> roles;
@@ -62,17 +157,121 @@ QHash<int, QByteArray> LogHandler::roleNames() const
     roles[TypeRole] = "type";
     roles[MessageRole] = "message";
     roles[ColorRole] = "logColor";
+    roles[ComponentRole] = "component";
+    roles[TimestampMsRole] = "timestampMs";
     return roles;
 }
 
 void LogHandler::clear()
 {
     beginResetModel();
-    m_messages.clear();
+    // Sin reutilizar la memoria de un buffer que pudo crecer mucho
+    m_messages = QVector<LogMessage>(kInitialCapacity);
+    m_head = 0;
+    m_firstSeq += m_count;
+    m_count = 0;
+    m_memoryUsage = 0;
+    for (std::deque<qint64> &rows : m_levelRows)
+        rows.clear();
+    for (std::deque<qint64> &rows : m_componentRows)
+        rows.clear();
     endResetModel();
+    emit countChanged();
+}
+
+qint64 LogHandler::recordBytes(const LogMessage &msg)
+{
+    return qint64(sizeof(LogMessage)) + qint64(msg.message.capacity()) * qint64(sizeof(QChar));
+}
+
+bool LogHandler::compressRotatedLogs() const
+{
+    return m_fileWriter->compressRotated();
+}
+
+void LogHandler::setCompressRotatedLogs(bool compress)
+{
+    if (compressRotatedLogs() == compress)
+        return;
+    m_fileWriter->setCompressRotated(compress);
+    QSettings settings(QSettings::IniFormat, QSettings::UserScope,
+                       "org.lazheart", "minecraft-launcher");
+    settings.setValue("logging/compressRotated", compress);
+    emit compressRotatedLogsChanged();
+}
+
+void LogHandler::setMemoryBudgetMb(int mb)
+{
+    mb = qBound(kMinBudgetMb, mb, kMaxBudgetMb);
+    if (memoryBudgetMb() == mb)
+        return;
+    m_memoryBudget = qint64(mb) * 1024 * 1024;
+    QSettings settings(QSettings::IniFormat, QSettings::UserScope,
+                       "org.lazheart", "minecraft-launcher");
+    settings.setValue("logging/memoryBudgetMb", mb);
+
+    const int before = m_count;
+    evictFor(0);
+    // Si sobra mucho sitio tras reducirlo, devolverlo
+    if (m_messages.size() > kInitialCapacity && m_count < m_messages.size() / 4) {
+        QVector<LogMessage> compact(qMax(kInitialCapacity, m_count * 2));
+        for (int i = 0; i < m_count; ++i)
+            compact[i] = std::move(slot(i));
+        m_messages = compact;
+        m_head = 0;
+    }
+    emit memoryBudgetChanged();
+    if (m_count != before)
+        emit countChanged();
+}
+
+void LogHandler::evictFor(qint64 incoming)
+{
+    int overflow = 0;
+    qint64 usage = m_memoryUsage;
+    while (overflow < m_count && usage + incoming > m_memoryBudget)
+        usage -= recordBytes(at(overflow++));
+    if (overflow == 0)
+        return;
+
+    // Un solo remove: las filas más antiguas se descartan moviendo m_head,
+    // sin desplazar nada; el hueco se vacía para liberar el texto ya
+    beginRemoveRows(QModelIndex(), 0, overflow - 1);
+    for (int i = 0; i < overflow; ++i) {
+        // Son las más antiguas: su secuencia está al principio de cada índice
+        LogMessage &msg = slot(i);
+        m_levelRows[static_cast<int>(msg.level)].pop_front();
+        if (!msg.component.isEmpty()) {
+            auto it = m_componentRows.find(msg.component);
+            if (it != m_componentRows.end() && !it->empty())
+                it->pop_front();
+        }
+        msg = LogMessage();
+    }
+    m_head = (m_head + overflow) % m_messages.size();
+    m_firstSeq += overflow;
+    m_count -= overflow;
+    m_memoryUsage = usage;
+    endRemoveRows();
+}
+
+void LogHandler::reserveRows(int count)
+{
+    if (count <= m_messages.size())
+        return;
+    QVector<LogMessage> grown(qMax(count, m_messages.size() * 2));
+    for (int i = 0; i < m_count; ++i)
+        grown[i] = std::move(slot(i));
+    m_messages = grown;
+    m_head = 0;
 }
 
 void LogHandler::saveLog(const QString &filePath)
+{
+    exportLog(filePath, filePath.endsWith(QLatin1String(".gz")), false);
+}
+
+bool LogHandler::exportLog(const QString &filePath, bool gzip, bool includeHistory)
 {
     QString path = QUrl(filePath).toLocalFile();
     if (path.isEmpty()) {
@@ -82,17 +281,24 @@ void LogHandler::saveLog(const QString &filePath)
              path = path.mid(7);
         }
     }
-    
-    QFile file(path);
-    if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        QTextStream out(&file);
-        for (const auto &msg : m_messages) {
-             out << "[" << msg.timestamp.toString("yyyy-MM-dd HH:mm:ss") << "] "
-                 << "[" << (msg.type == QtDebugMsg ? "DEBUG" : msg.type == QtInfoMsg ? "INFO" : msg.type == QtWarningMsg ? "WARNING" : "ERROR") << "] "
-                 << msg.message << "\n";
-        }
-        file.close();
+    if (gzip && !path.endsWith(QLatin1String(".gz")))
+        path += QStringLiteral(".gz");
+
+    LogExporter::Job job;
+    job.path = path;
+    job.gzip = gzip;
+    if (includeHistory) {
+        job.files = LogExporter::historyFiles(m_fileWriter->directory());
+        job.writer = m_fileWriter.get();
     }
+    if (job.files.isEmpty()) {
+        // Sólo se copian los registros (las cadenas son compartidas); el
+        // formateo se hace en el hilo de trabajo
+        job.messages.reserve(m_count);
+        for (int i = 0; i < m_count; ++i)
+            job.messages.append(at(i));
+    }
+    return m_exporter->start(std::move(job));
 }
 
 void LogHandler::copyToClipboard()
@@ -105,12 +311,21 @@ void LogHandler::copyToClipboard()
 
 QString LogHandler::getLogs()
 {
+    // Se reserva de una vez: sin realojar el texto a medida que crece
+    qint64 size = 0;
+    for (int i = 0; i < m_count; ++i)
+        size += at(i).message.size() + 33; // "[fecha] [NIVEL] " y salto
     QString logs;
-    for (const auto &msg : m_messages) {
-         logs += QString("[%1] [%2] %3\n")
-            .arg(msg.timestamp.toString("yyyy-MM-dd HH:mm:ss"))
-            .arg(msg.type == QtDebugMsg ? "DEBUG" : msg.type == QtInfoMsg ? "INFO" : msg.type == QtWarningMsg ? "WARNING" : "ERROR")
-            .arg(msg.message);
+    logs.reserve(int(size));
+    for (int i = 0; i < m_count; ++i) {
+        const LogMessage &msg = at(i);
+        logs += QLatin1Char('[');
+        logs += timeString(msg.timestamp);
+        logs += QLatin1String("] [");
+        logs += levelName(msg.level);
+        logs += QLatin1String("] ");
+        logs += msg.message;
+        logs += QLatin1Char('\n');
     }
     return logs;
 }
@@ -128,56 +343,136 @@ void LogHandler::messageOutput(QtMsgType type, const QMessageLogContext &context
     if (m_instance) {
         m_instance->appendMessage(type, msg);
     }
-    // Also print to original stdout/stderr
-    const int fd = (type == QtInfoMsg || type == QtDebugMsg) ? 1 : 2;
-    QFile streamDevice;
-    if (streamDevice.open(fd, QIODevice::WriteOnly, QFileDevice::DontCloseHandle)) {
-        QTextStream out(&streamDevice);
-        out << msg << "\n";
-        out.flush();
-        streamDevice.flush();
-    }
+    // Also print to original stdout/stderr (buffered, on the mirror thread)
+    ConsoleMirror::print(type, msg);
 }
 
 void LogHandler::appendMessage(QtMsgType type, const QString &msg)
 {
-    QString color;
-    switch (type) {
-        case QtDebugMsg: color = "#b0b0b0"; break; // Gray
-        case QtInfoMsg: color = "#ffffff"; break;  // White
-        case QtWarningMsg: color = "#ffcc00"; break; // Yellow
-        case QtCriticalMsg: 
-        case QtFatalMsg: color = "#ff5252"; break; // Red
-        default: color = "#ffffff"; break;
+    LogMessage logMsg;
+    logMsg.timestamp = QDateTime::currentMSecsSinceEpoch();
+    m_fileWriter->append(logMsg.timestamp, type, msg);
+    logMsg.level = levelFor(type);
+    logMsg.message = msg;
+    logMsg.component = parseComponent(msg);
+    m_queue.push(std::move(logMsg));
+
+    // Sólo el primer mensaje desde el último vaciado despierta al hilo de la
+    // GUI; el resto espera en la cola al mismo lote
+    if (!m_drainScheduled.exchange(true, std::memory_order_acq_rel)) {
+        QMetaObject::invokeMethod(this, [this]() {
+            if (!m_drainTimer->isActive())
+                m_drainTimer->start();
+        }, Qt::QueuedConnection);
     }
+}
 
-    // Ensure model updates happen on the owning thread even when logs arrive
-    // from worker threads.
-    QMetaObject::invokeMethod(this, "appendMessageOnMainThread",
-                              Qt::QueuedConnection,
-                              Q_ARG(int, static_cast<int>(type)),
-                              Q_ARG(QString, msg),
-                              Q_ARG(QString, color),
-                              Q_ARG(QDateTime, QDateTime::currentDateTime()));
+QVariantList LogHandler::logCategories() const
+{
+    QVariantList list;
+    for (QLoggingCategory *category : LogCategories::all()) {
+        QVariantMap entry;
+        entry["name"] = QString::fromLatin1(category->categoryName());
+        entry["debug"] = category->isDebugEnabled();
+        list.append(entry);
+    }
+    return list;
 }
 
-void LogHandler::appendMessageOnMainThread(int type, const QString &msg,
-                                           const QString &color,
-                                           const QDateTime &timestamp)
+bool LogHandler::setCategoryDebug(const QString &name, bool enabled)
 {
-    LogMessage logMsg;
-    logMsg.timestamp = timestamp;
-    logMsg.type = static_cast<QtMsgType>(type);
-    logMsg.message = msg;
-    logMsg.color = color;
+    if (!LogCategories::setDebugEnabled(name, enabled))
+        return false;
+    emit logCategoriesChanged();
+    return true;
+}
 
-    if (m_messages.size() >= m_maxLines) {
-        beginRemoveRows(QModelIndex(), 0, 0);
-        m_messages.removeFirst();
-        endRemoveRows();
+QString LogHandler::parseComponent(const QString &msg)
+{
+    // Prefijo que añade Qt a los console.log de QML
+    int start = msg.startsWith(QLatin1String("qml: ")) ? 5 : 0;
+    if (start >= msg.size() || msg.at(start) != QLatin1Char('['))
+        return QString();
+    ++start;
+    // Sólo nombres cortos de una palabra: "[1/3]" o "[2024-...]" no cuentan
+    const int limit = qMin(msg.size(), start + 40);
+    for (int i = start; i < limit; ++i) {
+        const QChar c = msg.at(i);
+        if (c == QLatin1Char(']'))
+            return i > start ? msg.mid(start, i - start) : QString();
+        if (!c.isLetterOrNumber() && c != QLatin1Char('_') && c != QLatin1Char('.') &&
+            c != QLatin1Char(':'))
+            return QString();
     }
+    return QString();
+}
+
+void LogHandler::drainQueue()
+{
+    // Antes de vaciar: un mensaje que llegue a partir de aquí programa otro
+    // vaciado en lugar de perderse
+    m_drainScheduled.store(false, std::memory_order_release);
+
+    QVector<LogMessage> batch;
+    LogMessage msg;
+    while (m_queue.tryPop(msg))
+        batch.append(std::move(msg));
+    // Un productor a mitad de push(): su mensaje entra en el siguiente lote
+    if (!m_queue.isEmpty())
+        m_drainTimer->start();
 
-    beginInsertRows(QModelIndex(), m_messages.size(), m_messages.size());
-    m_messages.append(logMsg);
+    appendBatch(batch);
+}
+
+void LogHandler::appendBatch(const QVector<LogMessage> &batch)
+{
+    if (batch.isEmpty())
+        return;
+
+    // Del lote sólo se queda lo más reciente que quepa por sí solo en el
+    // presupuesto (al menos la última línea)
+    qint64 incoming = 0;
+    for (const LogMessage &msg : batch)
+        incoming += recordBytes(msg);
+    int skip = 0;
+    while (skip < batch.size() - 1 && incoming > m_memoryBudget)
+        incoming -= recordBytes(batch.at(skip++));
+    const int n = batch.size() - skip;
+
+    evictFor(incoming);
+    reserveRows(m_count + n);
+
+    beginInsertRows(QModelIndex(), m_count, m_count + n - 1);
+    // Internar el componente: todas las líneas de "[MinecraftManager]"
+    // comparten una sola cadena en lugar de una copia cada una. Los índices
+    // se actualizan antes de notificar, para que LogFilterModel los vea.
+    bool newComponents = false;
+    for (int i = 0; i < n; ++i) {
+        LogMessage &msg = slot(m_count + i);
+        msg = batch.at(skip + i);
+        const qint64 seq = m_firstSeq + m_count + i;
+        m_levelRows[static_cast<int>(msg.level)].push_back(seq);
+        if (msg.component.isEmpty())
+            continue;
+        auto it = m_componentSet.constFind(msg.component);
+        if (it != m_componentSet.constEnd()) {
+            msg.component = *it;
+        } else if (m_componentSet.size() < kMaxComponents) {
+            m_componentSet.insert(msg.component);
+            m_componentList.append(msg.component);
+            newComponents = true;
+        } else {
+            continue;
+        }
+        m_componentRows[msg.component].push_back(seq);
+    }
+    m_count += n;
+    m_memoryUsage += incoming;
     endInsertRows();
+    emit countChanged();
+
+    if (newComponents) {
+        m_componentList.sort(Qt::CaseInsensitive);
+        emit componentsChanged();
+    }
 }
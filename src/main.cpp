@@ -9,7 +9,10 @@
 #include "../include/pathmanager.h"
 #include "../include/profilemanager.h"
 #include "../include/versionsapihandler.h"
+#include "../include/logcategories.h"
+#include "../include/logfiltermodel.h"
 #include "../include/loghandler.h"
+#include "../include/stallwatchdog.h"
 #include "../include/thememanager.h"
 #include "../include/translator.h"
 #include <cstdio>
@@ -59,10 +62,19 @@ int main(int argc, char **argv) {
   // Initialize LogHandler
   LogHandler logHandler;
   qInstallMessageHandler(LogHandler::messageOutput);
+  // Categorías de depuración activadas en la sesión anterior
+  LogCategories::restore();
+  LogFilterModel logFilter(&logHandler);
+  // Paradas del bucle de eventos de la GUI (histograma en DebugCard)
+  StallWatchdog stallWatchdog;
 
   QQmlApplicationEngine engine;
 
   PathManager pathManager;
+  // Copia persistente del log en logsDir (escrita en su propio hilo)
+  logHandler.setLogDirectory(pathManager.logsDir());
+  QObject::connect(&pathManager, &PathManager::changed, &logHandler,
+                   [&]() { logHandler.setLogDirectory(pathManager.logsDir()); });
   MinecraftManager minecraftManager(&pathManager);
   ProfileManager profileManager;
   VersionsApiHandler versionsApiHandler;
@@ -75,14 +87,18 @@ int main(int argc, char **argv) {
   engine.rootContext()->setContextProperty("profileManager", &profileManager);
   engine.rootContext()->setContextProperty("versionsApiHandler", &versionsApiHandler);
   engine.rootContext()->setContextProperty("logHandler", &logHandler);
+  engine.rootContext()->setContextProperty("logFilter", &logFilter);
+  engine.rootContext()->setContextProperty("stallWatchdog", &stallWatchdog);
   engine.rootContext()->setContextProperty("themeManager", &themeManager);
   engine.rootContext()->setContextProperty("translator", &translator);
 
-  qDebug() << "[main] Exposed pathManager and minecraftManager to QML";
-  qDebug() << "[main] pathManager.versionsDir=" << pathManager.versionsDir();
-  qDebug() << "[main] pathManager.profilesDir=" << pathManager.profilesDir();
-  qDebug() << "[main] pathManager.mcpelauncherExtract="
-           << pathManager.mcpelauncherExtract();
+  qCDebug(lcUi) << "[main] Exposed pathManager and minecraftManager to QML";
+  qCDebug(lcPaths) << "[main] pathManager.versionsDir="
+                   << pathManager.versionsDir();
+  qCDebug(lcPaths) << "[main] pathManager.profilesDir="
+                   << pathManager.profilesDir();
+  qCDebug(lcPaths) << "[main] pathManager.mcpelauncherExtract="
+                   << pathManager.mcpelauncherExtract();
 
   const QUrl url(QStringLiteral("qrc:/main.qml"));
   engine.load(url);
@@ -125,8 +141,8 @@ int main(int argc, char **argv) {
         qWarning() << "[main] No installed/lastActive version found to import"
                    << worldArg;
       } else {
-        qDebug() << "[main] Launching import for .mcworld from CLI:" << worldArg
-                 << "into version" << targetVersion;
+        qCDebug(lcGame) << "[main] Launching import for .mcworld from CLI:"
+                        << worldArg << "into version" << targetVersion;
         minecraftManager.importSelected(worldArg, "World", targetVersion);
       }
     }
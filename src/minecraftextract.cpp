@@ -1,5 +1,6 @@
 #include "../include/minecraftextract.h"
 #include "../include/pathmanager.h"
+#include "../include/logcategories.h"
 
 #include <QProcess>
 #include <QDebug>
@@ -20,13 +21,13 @@ bool MinecraftExtract::extractApk(const QString &apkPath, const QString &name, Q
     QString versionsRoot = m_paths->versionsDir();
     QString targetDir = QDir(versionsRoot).filePath(name);
 
-    qDebug() << "MinecraftExtract: will extract to targetDir:" << targetDir;
+    qCDebug(lcInstall) << "MinecraftExtract: will extract to targetDir:" << targetDir;
 
     // Asegurar que existe el directorio destino antes de invocar el extractor
     QDir().mkpath(targetDir);
 
     QString extractor = m_paths->mcpelauncherExtract();
-    qDebug() << "MinecraftExtract: running extractor:" << extractor << "apk:" << apkPath << "target:" << targetDir;
+    qCDebug(lcInstall) << "MinecraftExtract: running extractor:" << extractor << "apk:" << apkPath << "target:" << targetDir;
 
     QProcess proc;
     QStringList args;
@@ -44,8 +45,8 @@ bool MinecraftExtract::extractApk(const QString &apkPath, const QString &name, Q
     QByteArray stdoutData = proc.readAllStandardOutput();
     QByteArray stderrData = proc.readAllStandardError();
 
-    qDebug() << "MinecraftExtract: extractor stdout:" << stdoutData;
-    if (!stderrData.isEmpty()) qDebug() << "MinecraftExtract: extractor stderr:" << stderrData;
+    qCDebug(lcInstall) << "MinecraftExtract: extractor stdout:" << stdoutData;
+    if (!stderrData.isEmpty()) qCWarning(lcInstall) << "MinecraftExtract: extractor stderr:" << stderrData;
 
     if (outStdErr) *outStdErr = QString::fromUtf8(stderrData);
 
@@ -55,6 +56,9 @@ bool MinecraftExtract::extractApk(const QString &apkPath, const QString &name, Q
     }
 
     int rc = proc.exitCode();
-    qDebug() << "MinecraftExtract: extractor exit code:" << rc;
+    if (rc != 0)
+        qCWarning(lcInstall) << "MinecraftExtract: extractor exit code:" << rc;
+    else
+        qCDebug(lcInstall) << "MinecraftExtract: extractor exit code:" << rc;
     return rc == 0;
 }
@@ -1,142 +1,244 @@
 #include "../include/minecraftlaunch.h"
 #include "../include/pathmanager.h"
+#include "../include/logcategories.h"
 
 #include <QProcess>
 #include <QProcessEnvironment>
 #include <QFileInfo>
 #include <QDebug>
 #include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace {
+const char *const kPresetFile = "launch_preset.json";
+}
+
+LaunchPreset LaunchPreset::fromJson(const QJsonObject &obj)
+{
+    LaunchPreset p;
+    p.gpu = obj.value("gpu").toString(p.gpu);
+    p.mangohud = obj.value("mangohud").toBool(p.mangohud);
+    p.gamemode = obj.value("gamemode").toBool(p.gamemode);
+    p.detach = obj.value("detach").toBool(p.detach);
+    p.profileMode = obj.value("profileMode").toString(p.profileMode);
+    p.env = obj.value("env").toObject().toVariantMap();
+    for (const QJsonValue &v : obj.value("extraArgs").toArray())
+        p.extraArgs << v.toString();
+    for (const QJsonValue &v : obj.value("cpus").toArray())
+        p.cpus << v.toInt();
+    p.nice = qBound(-20, obj.value("nice").toInt(p.nice), 19);
+    p.ioClass = obj.value("ioClass").toString(p.ioClass);
+    p.ioLevel = qBound(0, obj.value("ioLevel").toInt(p.ioLevel), 7);
+    p.shaderCache = obj.value("shaderCache").toBool(p.shaderCache);
+    p.shaderCacheMaxMb = qBound(64, obj.value("shaderCacheMaxMb").toInt(p.shaderCacheMaxMb),
+                                64 * 1024);
+    return p;
+}
+
+QJsonObject LaunchPreset::toJson() const
+{
+    QJsonObject obj;
+    obj["gpu"] = gpu;
+    obj["mangohud"] = mangohud;
+    obj["gamemode"] = gamemode;
+    obj["detach"] = detach;
+    obj["profileMode"] = profileMode;
+    obj["env"] = QJsonObject::fromVariantMap(env);
+    obj["extraArgs"] = QJsonArray::fromStringList(extraArgs);
+    QJsonArray cpuList;
+    for (int cpu : cpus)
+        cpuList.append(cpu);
+    obj["cpus"] = cpuList;
+    obj["nice"] = nice;
+    obj["ioClass"] = ioClass;
+    obj["ioLevel"] = ioLevel;
+    obj["shaderCache"] = shaderCache;
+    obj["shaderCacheMaxMb"] = shaderCacheMaxMb;
+    return obj;
+}
+
+ProcessPriority::Settings LaunchPreset::scheduling() const
+{
+    ProcessPriority::Settings s;
+    s.cpus = cpus;
+    s.nice = nice;
+    s.ioClass = ProcessPriority::ioClassFromString(ioClass);
+    s.ioLevel = ioLevel;
+    return s;
+}
 
 MinecraftLaunch::MinecraftLaunch(PathManager *paths, QObject *parent)
     : QObject(parent), m_paths(paths)
 {
 }
 
-bool MinecraftLaunch::runGame(const QString &versionPath,
-                              bool useNvidia,
-                              bool useZink,
-                              bool useShared,
-                              bool useMangohud)
+LaunchPreset MinecraftLaunch::loadPreset(const QString &versionPath) const
 {
-    if (!m_paths) {
-        qWarning() << "MinecraftLaunch::runGame: no PathManager";
-        return false;
+    QFile f(QDir(versionPath).filePath(kPresetFile));
+    if (!f.open(QIODevice::ReadOnly))
+        return LaunchPreset();
+
+    QJsonParseError err;
+    const QJsonDocument doc = QJsonDocument::fromJson(f.readAll(), &err);
+    if (err.error != QJsonParseError::NoError || !doc.isObject()) {
+        qWarning() << "MinecraftLaunch::loadPreset: invalid" << f.fileName()
+                   << err.errorString();
+        return LaunchPreset();
     }
+    return LaunchPreset::fromJson(doc.object());
+}
 
-    QString client = m_paths->mcpelauncherClient();
-    if (client.isEmpty()) {
-        qWarning() << "MinecraftLaunch::runGame: mcpelauncher-client not configured";
+bool MinecraftLaunch::savePreset(const QString &versionPath,
+                                 const LaunchPreset &preset) const
+{
+    QSaveFile f(QDir(versionPath).filePath(kPresetFile));
+    if (!f.open(QIODevice::WriteOnly)) {
+        qWarning() << "MinecraftLaunch::savePreset: cannot write" << f.fileName()
+                   << f.errorString();
         return false;
     }
+    f.write(QJsonDocument(preset.toJson()).toJson(QJsonDocument::Indented));
+    return f.commit();
+}
 
-    QString profilePath;
-    // derive profile path from versions folder name
-    QFileInfo vfi(versionPath);
-    QString versionName = vfi.fileName();
-    profilePath = QDir(m_paths->profilesDir()).filePath(versionName);
+LaunchSpec MinecraftLaunch::buildSpec(const QString &versionPath,
+                                      const LaunchPreset &preset,
+                                      const QStringList &clientArgs) const
+{
+    LaunchSpec spec;
+    if (!m_paths) {
+        qWarning() << "MinecraftLaunch::buildSpec: no PathManager";
+        return spec;
+    }
+
+    const QString client = m_paths->mcpelauncherClient();
+    if (client.isEmpty()) {
+        qWarning() << "MinecraftLaunch::buildSpec: mcpelauncher-client not configured";
+        return spec;
+    }
 
+    // Argumentos del cliente: datos del juego, perfil y extras
     QStringList args;
     args << QStringLiteral("-dg") << versionPath;
-    if (!useShared) {
-        args << QStringLiteral("-dd") << profilePath;
+    if (preset.profileMode != QLatin1String("shared"))
+        args << QStringLiteral("-dd") << dataDir(versionPath, preset);
+    args << preset.extraArgs << clientArgs;
+
+    // Envoltorios, del más externo al más interno:
+    // setsid gamemoderun mangohud <client> <args>
+    QStringList command;
+    if (preset.detach)
+        command << QStringLiteral("setsid");
+    if (preset.gamemode)
+        command << QStringLiteral("gamemoderun");
+    if (preset.mangohud)
+        command << QStringLiteral("mangohud");
+    command << client << args;
+
+    spec.program = command.takeFirst();
+    spec.arguments = command;
+
+    spec.environment = QProcessEnvironment::systemEnvironment();
+    if (preset.gpu == QLatin1String("zink")) {
+        spec.environment.insert("MESA_LOADER_DRIVER_OVERRIDE", "zink");
+    } else if (preset.gpu == QLatin1String("nvidia")) {
+        spec.environment.insert("__NV_PRIME_RENDER_OFFLOAD", "1");
+        spec.environment.insert("__VK_LAYER_NV_optimus", "NVIDIA_only");
+        spec.environment.insert("__GLX_VENDOR_LIBRARY_NAME", "nvidia");
+    } else if (preset.gpu == QLatin1String("prime")) {
+        spec.environment.insert("DRI_PRIME", "1");
     }
-
-    // The client accepts -ifp later when importing
-
-    QString program;
-    QStringList finalArgs;
-
-    // If using mangohud, run: mangohud <client> <args>
-    if (useMangohud) {
-        program = QStringLiteral("mangohud");
-        finalArgs = args;
-        finalArgs.prepend(client);
-    } else {
-        // Otherwise run with setsid to detach the client from the launcher
-        // command: setsid <client> <args>
-        program = QStringLiteral("setsid");
-        finalArgs = args;
-        finalArgs.prepend(client);
+    if (preset.shaderCache) {
+        // Cada versión con su propia caché: al cambiar de versión los shaders
+        // de la otra no expulsan a los de ésta y no hay que recompilarlos
+        const QDir cache(shaderCacheDir(versionPath));
+        const QString mesaDir = cache.filePath(QStringLiteral("mesa"));
+        const QString nvidiaDir = cache.filePath(QStringLiteral("nvidia"));
+        QDir().mkpath(mesaDir);
+        QDir().mkpath(nvidiaDir);
+        const QString maxMb = QString::number(preset.shaderCacheMaxMb);
+        spec.environment.insert("MESA_SHADER_CACHE_DIR", mesaDir);
+        spec.environment.insert("MESA_SHADER_CACHE_MAX_SIZE", maxMb + QStringLiteral("M"));
+        spec.environment.insert("__GL_SHADER_DISK_CACHE", "1");
+        spec.environment.insert("__GL_SHADER_DISK_CACHE_PATH", nvidiaDir);
+        spec.environment.insert("__GL_SHADER_DISK_CACHE_SIZE",
+                                QString::number(qint64(preset.shaderCacheMaxMb) * 1024 * 1024));
+        // El tamaño lo controla el launcher al terminar la sesión; la limpieza
+        // propia del driver podría vaciar la caché en mitad de la partida
+        spec.environment.insert("__GL_SHADER_DISK_CACHE_SKIP_CLEANUP", "1");
     }
+    // Las variables del preset tienen la última palabra
+    for (auto it = preset.env.constBegin(); it != preset.env.constEnd(); ++it)
+        spec.environment.insert(it.key(), it.value().toString());
 
-    QProcess *proc = new QProcess();
-    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
-    if (useZink) {
-        env.insert("MESA_LOADER_DRIVER_OVERRIDE", "zink");
-    } else if (useNvidia) {
-        env.insert("__NV_PRIME_RENDER_OFFLOAD", "1");
-        env.insert("__VK_LAYER_NV_optimus", "NVIDIA_only");
-        env.insert("__GLX_VENDOR_LIBRARY_NAME", "nvidia");
-    }
-    proc->setProcessEnvironment(env);
+    return spec;
+}
 
-    qDebug() << "MinecraftLaunch::runGame launching" << program << finalArgs;
-    proc->start(program, finalArgs);
-    if (!proc->waitForStarted(5000)) {
-        qWarning() << "MinecraftLaunch::runGame failed to start";
-        proc->deleteLater();
-        return false;
-    }
+QString MinecraftLaunch::shaderCacheDir(const QString &versionPath) const
+{
+    if (!m_paths)
+        return QString();
+    const QString versionName = QFileInfo(versionPath).fileName();
+    return QDir(QDir(m_paths->profilesDir()).filePath(versionName))
+        .filePath(QStringLiteral("shader-cache"));
+}
 
-    // Let the process run detached; delete proc when finished
-    connect(proc, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), proc, &QObject::deleteLater);
-    return true;
+QString MinecraftLaunch::dataDir(const QString &versionPath,
+                                const LaunchPreset &preset) const
+{
+    if (!m_paths)
+        return QString();
+    if (preset.profileMode == QLatin1String("shared"))
+        return defaultDataDir();
+    // derive profile path from versions folder name
+    const QString versionName = QFileInfo(versionPath).fileName();
+    return QDir(m_paths->profilesDir()).filePath(versionName);
+}
+
+QString MinecraftLaunch::defaultDataDir()
+{
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation))
+        .filePath(QStringLiteral("mcpelauncher"));
+}
+
+void MinecraftLaunch::start(QProcess *proc, const LaunchSpec &spec)
+{
+    qCDebug(lcGame) << "MinecraftLaunch: launching" << spec.program << spec.arguments;
+    proc->setProcessEnvironment(spec.environment);
+    proc->start(spec.program, spec.arguments);
 }
 
 bool MinecraftLaunch::importFile(const QString &versionPath,
                                  const QString &filePath,
-                                 bool useShared,
-                                 bool useNvidia,
-                                 bool useZink,
-                                 bool useMangohud)
+                                 const LaunchPreset &preset)
 {
-    if (!m_paths) {
-        qWarning() << "MinecraftLaunch::importFile: no PathManager";
+    const LaunchSpec spec = buildSpec(versionPath, preset,
+                                      {QStringLiteral("-ifp"), filePath});
+    if (!spec.isValid())
         return false;
-    }
-
-    QString client = m_paths->mcpelauncherClient();
-    if (client.isEmpty()) {
-        qWarning() << "MinecraftLaunch::importFile: mcpelauncher-client not configured";
-        return false;
-    }
-
-    QFileInfo vfi(versionPath);
-    QString versionName = vfi.fileName();
-    QString profilePath = QDir(m_paths->profilesDir()).filePath(versionName);
-
-    QStringList args;
-    args << QStringLiteral("-dg") << versionPath;
-    if (!useShared) args << QStringLiteral("-dd") << profilePath;
-    args << QStringLiteral("-ifp") << filePath;
-
-    QString program = client;
-    QStringList finalArgs = args;
-    if (useMangohud) {
-        finalArgs = args;
-        finalArgs.prepend(program);
-        program = QStringLiteral("mangohud");
-    }
 
     QProcess *proc = new QProcess();
-    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
-    if (useZink) {
-        env.insert("MESA_LOADER_DRIVER_OVERRIDE", "zink");
-    } else if (useNvidia) {
-        env.insert("__NV_PRIME_RENDER_OFFLOAD", "1");
-        env.insert("__VK_LAYER_NV_optimus", "NVIDIA_only");
-        env.insert("__GLX_VENDOR_LIBRARY_NAME", "nvidia");
-    }
-    proc->setProcessEnvironment(env);
-
-    qDebug() << "MinecraftLaunch::importFile launching" << program << finalArgs;
-    proc->start(program, finalArgs);
-    if (!proc->waitForStarted(5000)) {
-        qWarning() << "MinecraftLaunch::importFile failed to start";
+    // Nadie lee su salida: reenviada a la del launcher, un cliente verboso
+    // no llena la tubería ni se queda bloqueado escribiendo
+    proc->setProcessChannelMode(QProcess::ForwardedChannels);
+    connect(proc, &QProcess::started, this, [this, versionPath, filePath]() {
+        qCDebug(lcGame) << "MinecraftLaunch::importFile started" << filePath;
+        emit importStarted(versionPath, filePath);
+    });
+    connect(proc, &QProcess::errorOccurred, this,
+            [this, proc, versionPath, filePath](QProcess::ProcessError error) {
+        if (error != QProcess::FailedToStart)
+            return;
+        qWarning() << "MinecraftLaunch::importFile failed to start:" << proc->errorString();
+        emit importFailed(versionPath, filePath, proc->errorString());
         proc->deleteLater();
-        return false;
-    }
-
+    });
     connect(proc, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), proc, &QObject::deleteLater);
+
+    start(proc, spec);
     return true;
 }
@@ -7,11 +7,25 @@
 #include <QFileInfo>
 #include <QStandardPaths>
 
+#include "../include/gameinstance.h"
+#include "../include/gameinstanceregistry.h"
+#include "../include/gamelog.h"
+#include "../include/launchmetrics.h"
+#include "../include/logcategories.h"
 #include "../include/minecraftextract.h"
 #include "../include/minecraftlaunch.h"
+#include "../include/processpriority.h"
+#include "../include/processtelemetry.h"
+#include "../include/shadercache.h"
+#include "../include/stallwatchdog.h"
+#include "../include/trashpurger.h"
+#include "../include/versionprefetcher.h"
+#include "../include/worldbackup.h"
 #include <QFile>
 #include <QProcess>
+#include <QTimer>
 #include <QFuture>
+#include <QSet>
 #include <QFutureWatcher>
 #include <QtConcurrent/QtConcurrentRun>
 
@@ -39,16 +53,98 @@ struct MinecraftManager::InstallContext {
 MinecraftManager::MinecraftManager(PathManager *paths, QObject *parent)
   : QObject(parent), m_pathManager(paths) {
   m_installedVersion = QString();
-  qDebug() << "[MinecraftManager] Constructed. PathManager present:"
-           << (m_pathManager != nullptr);
+  qCDebug(lcVersions) << "[MinecraftManager] Constructed. PathManager present:"
+                      << (m_pathManager != nullptr);
+
+  m_instances = new GameInstanceRegistry(this);
+  // Modelos vacíos para QML mientras no se ha lanzado ninguna instancia
+  m_idleTelemetry = new ProcessTelemetry(this);
+  m_idleGameLog = new GameLog(this);
+  m_launchMetrics = new LaunchMetrics(this);
+  m_prefetcher = new VersionPrefetcher(this);
+  if (m_pathManager) {
+    auto updateMetricsPath = [this]() {
+      m_launchMetrics->setStorePath(QDir(m_pathManager->launcherDir())
+                                        .filePath("launch_metrics.json"));
+    };
+    updateMetricsPath();
+    connect(m_pathManager, &PathManager::changed, this, updateMetricsPath);
+  }
+
+  m_launcher = new MinecraftLaunch(m_pathManager, this);
+  connect(m_launcher, &MinecraftLaunch::importStarted, this,
+          [this](const QString &versionPath, const QString &filePath) {
+            qCDebug(lcGame) << "importSelected: import started for" << filePath
+                            << "into" << versionPath;
+            emit importSucceeded(versionPath, filePath);
+            // If we staged the file, try to remove it after starting the
+            // import (removeStagedFile only touches files under imports/)
+            if (m_pathManager && m_pathManager->removeStagedFile(filePath))
+              qCDebug(lcGame) << "importSelected: removed staged file:"
+                              << filePath;
+          });
+  connect(m_launcher, &MinecraftLaunch::importFailed, this,
+          [this](const QString &versionPath, const QString &filePath,
+                 const QString &reason) {
+            qWarning() << "importSelected: launcher failed to start:" << reason;
+            emit importFailed(versionPath, filePath,
+                              "Failed to start client for import: " + reason);
+            if (m_pathManager)
+              m_pathManager->removeStagedFile(filePath);
+          });
+
+  // Borrados interrumpidos en la sesión anterior: se terminan ahora, en
+  // segundo plano
+  m_trash = new TrashPurger(this);
+  connect(m_trash, &TrashPurger::busyChanged, this,
+          &MinecraftManager::trashBusyChanged);
+  connect(m_trash, &TrashPurger::progressChanged, this,
+          &MinecraftManager::trashProgressChanged);
+  connect(m_trash, &TrashPurger::purgeFinished, this,
+          [this](qint64 freedBytes, bool cancelled) {
+            if (!cancelled)
+              emit trashPurged(freedBytes / (1024.0 * 1024.0));
+          });
+  {
+    QStringList leftovers;
+    for (const QString &root : {versionsDir(), profilesDir()}) {
+      const QString trash = QDir(root).filePath(TrashPurger::kTrashDirName);
+      if (QFileInfo(trash).isDir())
+        leftovers << trash;
+    }
+    if (!leftovers.isEmpty()) {
+      qCDebug(lcVersions) << "[MinecraftManager] resuming trash purge:"
+                          << leftovers;
+      m_trash->purge(leftovers);
+    }
+  }
+
+  m_worldBackup = new WorldBackup(this);
+  connect(m_worldBackup, &WorldBackup::busyChanged, this,
+          &MinecraftManager::worldBackupBusyChanged);
+  connect(m_worldBackup, &WorldBackup::progressChanged, this,
+          &MinecraftManager::worldBackupProgressChanged);
+  connect(m_worldBackup, &WorldBackup::exportFinished, this,
+          [this](const QString &worldDir, const QString &destPath, bool ok,
+                 const QString &error) {
+            if (ok)
+              emit worldExportSucceeded(worldDir, destPath);
+            else
+              emit worldExportFailed(worldDir, destPath, error);
+          });
+  connect(m_worldBackup, &WorldBackup::backupFinished, this,
+          &MinecraftManager::worldBackupFinished);
+  connect(m_worldBackup, &WorldBackup::restoreFinished, this,
+          &MinecraftManager::worldRestoreFinished);
 
   // QML-visible startup messages
   qDebug() << "qml: [QML] Launcher iniciado";
   qDebug() << "qml: [QML] Versión:" << getLauncherVersion();
 
   // Report versionsDir early so logs match expected output
-  qDebug() << "[MinecraftManager] checkInstallation() using versionsDir:"
-           << versionsDir();
+  qCDebug(lcPaths)
+      << "[MinecraftManager] checkInstallation() using versionsDir:"
+      << versionsDir();
 
   // Check for presence of extractor and client binaries (from PathManager)
   if (m_pathManager) {
@@ -59,23 +155,24 @@ MinecraftManager::MinecraftManager(PathManager *paths, QObject *parent)
     QFileInfo cliFi(client);
 
     if (extFi.isAbsolute() && extFi.exists()) {
-      qDebug() << "[MinecraftManager] Found extractor binary:"
-               << extFi.absoluteFilePath();
+      qCDebug(lcPaths) << "[MinecraftManager] Found extractor binary:"
+                       << extFi.absoluteFilePath();
     } else if (!extFi.isAbsolute() && !extractor.isEmpty() &&
                QStandardPaths::findExecutable(extractor).isEmpty() == false) {
-      qDebug() << "[MinecraftManager] Found extractor binary on PATH:"
-               << extractor;
+      qCDebug(lcPaths) << "[MinecraftManager] Found extractor binary on PATH:"
+                       << extractor;
     } else {
       qWarning() << "[MinecraftManager] extractor binary NOT found:"
                  << extractor;
     }
 
     if (cliFi.isAbsolute() && cliFi.exists()) {
-      qDebug() << "[MinecraftManager] Found client binary:"
-               << cliFi.absoluteFilePath();
+      qCDebug(lcPaths) << "[MinecraftManager] Found client binary:"
+                       << cliFi.absoluteFilePath();
     } else if (!cliFi.isAbsolute() && !client.isEmpty() &&
                QStandardPaths::findExecutable(client).isEmpty() == false) {
-      qDebug() << "[MinecraftManager] Found client binary on PATH:" << client;
+      qCDebug(lcPaths) << "[MinecraftManager] Found client binary on PATH:"
+                       << client;
     } else {
       qWarning() << "[MinecraftManager] client binary NOT found:" << client;
     }
@@ -95,7 +192,7 @@ MinecraftManager::MinecraftManager(PathManager *paths, QObject *parent)
 }
 
 void MinecraftManager::cancelInstall() {
-  qDebug() << "[MinecraftManager] cancelInstall() requested";
+  qCDebug(lcInstall) << "[MinecraftManager] cancelInstall() requested";
   m_installCancelRequested = true;
 }
 
@@ -118,18 +215,38 @@ QString MinecraftManager::versionsDir() const {
   return QDir::cleanPath(appData + "/versions");
 }
 
+QString MinecraftManager::profilesDir() const {
+  if (m_pathManager)
+    return m_pathManager->profilesDir();
+
+  // Sin PathManager: variable de entorno o hermano de versionsDir()
+  QByteArray env = qgetenv("MINECRAFT_PROFILES_DIR");
+  if (!env.isEmpty())
+    return QString::fromUtf8(env);
+  QString vdirRoot = versionsDir();
+  int idx = vdirRoot.indexOf("/versions");
+  if (idx != -1)
+    return vdirRoot.replace(idx, 9, "/profiles");
+  QDir parentDir(vdirRoot);
+  parentDir.cdUp();
+  return QDir(parentDir.absolutePath()).filePath("profiles");
+}
+
 #include <QDateTime>
 #include <QDebug>
 #include <QDir>
 #include <QFileInfo>
 #include <QJsonArray>
 #include <QJsonDocument>
+#include <QUrl>
 
 QVariantList MinecraftManager::getAvailableVersions() {
+  StallWatchdog::OperationScope operation("scan");
   QVariantList list;
   QString dirPath = versionsDir();
 
-  qDebug() << "[MinecraftManager] Scanning versions directory:" << dirPath;
+  qCDebug(lcVersions) << "[MinecraftManager] Scanning versions directory:"
+                      << dirPath;
 
   QDir dir(dirPath);
   if (!dir.exists()) {
@@ -204,7 +321,8 @@ QVariantList MinecraftManager::getAvailableVersions() {
     list.append(m);
   }
 
-  qDebug() << "[MinecraftManager] Found" << list.size() << "versions";
+  qCDebug(lcVersions) << "[MinecraftManager] Found" << list.size()
+                      << "versions";
 
   if (m_lastActiveVersion.isEmpty() && !candidateLastVersion.isEmpty()) {
       m_lastActiveVersion = candidateLastVersion;
@@ -223,8 +341,9 @@ QVariantList MinecraftManager::getAvailableVersions() {
 bool MinecraftManager::checkInstallation() {
   // Stub simple: comprobar que existe al menos una versión
   QDir dir(versionsDir());
-  qDebug() << "[MinecraftManager] checkInstallation() using versionsDir:"
-           << versionsDir();
+  qCDebug(lcVersions)
+      << "[MinecraftManager] checkInstallation() using versionsDir:"
+      << versionsDir();
   bool installed = dir.exists() &&
                    !dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot).isEmpty();
 
@@ -236,7 +355,7 @@ bool MinecraftManager::checkInstallation() {
 }
 
 bool MinecraftManager::isRunning() const {
-  return m_gameProcess && m_gameProcess->state() != QProcess::NotRunning;
+  return m_instances->liveCount() > 0;
 }
 
 QString MinecraftManager::status() const {
@@ -247,22 +366,13 @@ QString MinecraftManager::status() const {
 
 bool MinecraftManager::runGame(const QString &versionPath,
                                const QString &unused, const QString &profile) {
+  StallWatchdog::OperationScope operation("launch");
   Q_UNUSED(unused);
-  qDebug() << "MinecraftManager::runGame version:" << versionPath
-           << "profile:" << profile;
+  qCDebug(lcGame) << "MinecraftManager::runGame version:" << versionPath
+                  << "profile:" << profile;
   if (!m_pathManager) {
     qWarning() << "runGame: no PathManager";
-    return false;
-  }
-
-  if (isRunning()) {
-    qWarning() << "runGame: game already running";
-    return false;
-  }
-
-  QString client = m_pathManager->mcpelauncherClient();
-  if (client.isEmpty()) {
-    qWarning() << "runGame: mcpelauncher-client not configured";
+    emit launchFailed(QStringLiteral("Internal error: no PathManager"));
     return false;
   }
 
@@ -275,8 +385,16 @@ bool MinecraftManager::runGame(const QString &versionPath,
     vfi.setFile(fullVersionPath);
   }
 
-  // Update last active version
+  // Varias versiones pueden ejecutarse a la vez, pero no dos instancias de
+  // la misma: compartirían el directorio de datos del perfil.
   QString versionName = vfi.fileName();
+  if (m_instances->liveForVersion(versionName)) {
+    qWarning() << "runGame: version already running:" << versionName;
+    emit launchFailed(QStringLiteral("Version already running"));
+    return false;
+  }
+
+  // Update last active version
   if (m_lastActiveVersion != versionName) {
     m_lastActiveVersion = versionName;
     emit lastActiveVersionChanged();
@@ -284,151 +402,284 @@ bool MinecraftManager::runGame(const QString &versionPath,
 
   if (!QDir(fullVersionPath).exists()) {
     qWarning() << "runGame: version path does not exist:" << fullVersionPath;
+    emit launchFailed(QStringLiteral("Version not found: %1").arg(versionName));
     return false;
   }
 
-  QString profilePath =
-      QDir(m_pathManager->profilesDir()).filePath(versionName);
+  // Mismo preset (GPU, envoltorios, perfil, entorno) que usa la importación
+  const LaunchPreset preset = m_launcher->loadPreset(fullVersionPath);
+  const LaunchSpec spec = m_launcher->buildSpec(fullVersionPath, preset);
+  if (!spec.isValid()) {
+    qWarning() << "runGame: mcpelauncher-client not configured";
+    emit launchFailed(QStringLiteral("mcpelauncher-client not configured"));
+    return false;
+  }
 
-  QStringList args;
-  args << QStringLiteral("-dg") << fullVersionPath;
-  if (!profile.isEmpty()) {
-    args << QStringLiteral("-dd") << profilePath;
+  // Con profileMode "shared" varias versiones usan el mismo directorio de
+  // datos; dos clientes escribiendo a la vez en él corromperían mundos y
+  // opciones
+  const QString dataDir = m_launcher->dataDir(fullVersionPath, preset);
+  if (GameInstance *other = m_instances->liveForDataDir(dataDir)) {
+    const QString reason =
+        QStringLiteral("Profile directory already in use by %1")
+            .arg(other->versionName());
+    qWarning() << "runGame:" << reason;
+    emit launchFailed(reason);
+    return false;
   }
 
-  QProcess *proc = new QProcess(this);
-  QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
-  proc->setProcessEnvironment(env);
+  auto *instance = new GameInstance(m_instances->nextId(), versionName,
+                                    fullVersionPath, profile);
+  instance->setDataDir(dataDir);
+  instance->setStopGraceMs(m_stopGraceMs);
+  connect(instance, &GameInstance::statusChanged, this,
+          &MinecraftManager::refreshGameState);
+  connect(instance, &GameInstance::launchFailed, this,
+          &MinecraftManager::launchFailed);
+  connect(instance, &GameInstance::crashed, this,
+          [this, instance](const QString &reason, const QString &reportPath) {
+            handleCrash(instance, reason, reportPath);
+          });
+  connect(instance, &GameInstance::finished, this,
+          [this, instance](int, QProcess::ExitStatus, bool killed) {
+            if (!instance->hasCrashed() &&
+                instance->uptimeMs() >= kStableUptimeMs)
+              m_relaunchAttempts.remove(instance->versionName());
+            // Los drivers no limpian la caché (SKIP_CLEANUP); se recorta
+            // aquí, con el juego ya cerrado
+            pruneShaderCache(instance->versionPath());
+            emit gameStopped(killed);
+          });
+  connect(instance, &QObject::destroyed, this, [this]() {
+    // clearFinished() puede borrar la instancia actual
+    if (m_currentInstance.isNull())
+      emit currentInstanceChanged();
+  });
+  m_instances->add(instance);
+  m_currentInstance = instance;
+  emit currentInstanceChanged();
+
+  instance->start(spec, preset.scheduling(), m_pathManager->logsDir(),
+                  m_launchMetrics);
+  refreshGameState();
+  return true;
+}
 
-  proc->start(client, args);
-  if (!proc->waitForStarted(5000)) {
-    qWarning() << "runGame: failed to start";
-    proc->deleteLater();
-    return false;
+void MinecraftManager::refreshGameState() {
+  // Estado agregado de todas las instancias para las propiedades globales;
+  // stopPhase y status siguen a la instancia actual (la última lanzada)
+  bool launching = false;
+  for (GameInstance *inst : m_instances->liveInstances())
+    launching = launching || inst->isLaunching();
+
+  const QString phase = m_currentInstance ? m_currentInstance->stopPhase()
+                                          : QString();
+  QString status;
+  if (launching)
+    status = QStringLiteral("Launching");
+  else if (m_currentInstance &&
+           m_currentInstance->status() == QLatin1String("stopping"))
+    status = QStringLiteral("Stopping");
+  else if (isRunning())
+    status = QStringLiteral("Running");
+  else
+    status = QStringLiteral("Stopped");
+
+  const bool running = isRunning();
+  ProcessPriority::setGameSessionActive(running);
+
+  if (m_launching != launching) {
+    m_launching = launching;
+    emit launchingChanged();
+  }
+  if (m_stopPhase != phase) {
+    m_stopPhase = phase;
+    emit stopPhaseChanged();
+  }
+  if (m_status != status) {
+    m_status = status;
+    emit statusChanged();
+  }
+  if (m_wasRunning != running) {
+    m_wasRunning = running;
+    emit isRunningChanged();
+  }
+}
+
+void MinecraftManager::handleCrash(GameInstance *instance,
+                                   const QString &reason,
+                                   const QString &reportPath) {
+  const QString versionName = instance->versionName();
+  // Una sesión larga no cuenta como fallo de arranque en bucle
+  if (instance->uptimeMs() >= kStableUptimeMs)
+    m_relaunchAttempts.remove(versionName);
+
+  int delayMs = 0;
+  const int attempt = m_relaunchAttempts.value(versionName);
+  if (m_autoRelaunch && attempt < m_maxRelaunchAttempts) {
+    delayMs = qMin(kRelaunchBaseMs << qMin(attempt, 16), kRelaunchMaxMs);
+    m_relaunchAttempts[versionName] = attempt + 1;
+    const QString versionPath = instance->versionPath();
+    const QString profile = instance->profile();
+    qWarning() << "[MinecraftManager]" << versionName << "crashed (" << reason
+               << "), relaunch" << attempt + 1 << "/" << m_maxRelaunchAttempts
+               << "in" << delayMs << "ms";
+    QTimer::singleShot(delayMs, this, [this, versionName, versionPath,
+                                       profile]() {
+      // Se pudo desactivar o lanzar a mano mientras tanto
+      if (!m_autoRelaunch || m_instances->liveForVersion(versionName))
+        return;
+      runGame(versionPath, QString(), profile);
+    });
+  } else {
+    qWarning() << "[MinecraftManager]" << versionName << "crashed:" << reason;
   }
+  emit gameCrashed(versionName, reason, reportPath, delayMs);
+}
 
-  m_gameProcess = proc;
-  m_status = QStringLiteral("Running");
-  emit statusChanged();
-  emit isRunningChanged();
+void MinecraftManager::setAutoRelaunch(bool enabled) {
+  if (m_autoRelaunch == enabled)
+    return;
+  m_autoRelaunch = enabled;
+  m_relaunchAttempts.clear();
+  emit autoRelaunchChanged();
+}
 
-  connect(proc, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
-          this, [this](int code, QProcess::ExitStatus es) {
-            Q_UNUSED(code);
-            Q_UNUSED(es);
-            m_status = QStringLiteral("Stopped");
-            emit statusChanged();
-            m_gameProcess = nullptr;
-            emit isRunningChanged();
-          });
+void MinecraftManager::setMaxRelaunchAttempts(int attempts) {
+  attempts = qBound(1, attempts, 100);
+  if (m_maxRelaunchAttempts == attempts)
+    return;
+  m_maxRelaunchAttempts = attempts;
+  emit autoRelaunchChanged();
+}
 
-  return true;
+QObject *MinecraftManager::telemetry() const {
+  if (m_currentInstance)
+    return m_currentInstance->telemetry();
+  return m_idleTelemetry;
+}
+
+QObject *MinecraftManager::gameLog() const {
+  if (m_currentInstance)
+    return m_currentInstance->gameLog();
+  return m_idleGameLog;
+}
+
+QObject *MinecraftManager::instances() const { return m_instances; }
+
+QObject *MinecraftManager::currentInstance() const {
+  return m_currentInstance.data();
+}
+
+QObject *MinecraftManager::launchMetrics() const { return m_launchMetrics; }
+
+void MinecraftManager::prefetchVersion(const QString &versionPath) {
+  // Con el juego abierto la versión ya está en memoria y la lectura sólo
+  // competiría con él por el disco
+  if (versionPath.isEmpty() || isRunning())
+    return;
+  const QString dir = resolveVersionPath(versionPath);
+  if (QFileInfo(dir).isDir())
+    m_prefetcher->prefetch(dir);
+}
+
+void MinecraftManager::stopGame(const QString &versionName) {
+  GameInstance *instance = versionName.isEmpty()
+                               ? m_currentInstance.data()
+                               : m_instances->liveForVersion(versionName);
+  qCDebug(lcGame) << "MinecraftManager::stopGame()" << versionName
+                  << "instance:" << (instance ? instance->instanceId() : 0);
+  if (instance)
+    instance->stop();
+}
+
+bool MinecraftManager::isVersionRunning(const QString &versionName) const {
+  return m_instances->liveForVersion(versionName) != nullptr;
+}
+
+bool MinecraftManager::idleWorkersDuringGame() const {
+  return ProcessPriority::idleWorkersEnabled();
 }
 
-void MinecraftManager::stopGame() {
-  qDebug() << "MinecraftManager::stopGame()";
-  if (!m_gameProcess)
+void MinecraftManager::setIdleWorkersDuringGame(bool enabled) {
+  if (ProcessPriority::idleWorkersEnabled() == enabled)
     return;
-  m_gameProcess->terminate();
-  if (!m_gameProcess->waitForFinished(3000)) {
-    m_gameProcess->kill();
-  }
-  m_status = QStringLiteral("Stopped");
-  emit statusChanged();
-  m_gameProcess = nullptr;
-  emit isRunningChanged();
+  ProcessPriority::setIdleWorkersEnabled(enabled);
+  emit idleWorkersDuringGameChanged();
+}
+
+void MinecraftManager::setStopGraceMs(int ms) {
+  ms = qMax(0, ms);
+  if (m_stopGraceMs == ms)
+    return;
+  m_stopGraceMs = ms;
+  for (GameInstance *inst : m_instances->liveInstances())
+    inst->setStopGraceMs(ms);
+  emit stopGraceMsChanged();
 }
 
 void MinecraftManager::deleteVersion(const QString &versionPath,
                                      bool deleteProfile) {
-  qDebug() << "Deleting version at path:" << versionPath
-           << ", deleteProfile:" << deleteProfile;
-  if (versionPath.isEmpty()) {
-    qDebug() << "No version path provided.";
-    return;
-  }
-  // Si se pasó únicamente el nombre (no contiene '/'), construir la ruta
-  // completa
-  QString vpath = versionPath;
-  if (!vpath.contains(QDir::separator()) && !vpath.startsWith("/")) {
-    qDebug()
-        << "Interpreting versionPath as name only, constructing full path.";
-    vpath = QDir(versionsDir()).filePath(vpath);
-  }
-
-  QDir vdir(vpath);
-  bool removed = vdir.removeRecursively();
-  qDebug() << "[MinecraftManager] removeRecursively(" << vpath << ") =>"
-           << removed;
-
-  if (deleteProfile) {
-    // Intentar derivar profiles dir de forma segura
-    QString pdirPath;
-    // Priorizar variable de entorno MINECRAFT_PROFILES_DIR
-    QByteArray env = qgetenv("MINECRAFT_PROFILES_DIR");
-    if (!env.isEmpty()) {
-      pdirPath = QString::fromUtf8(env);
-    } else {
-      // Si versionsDir contiene '/versions', reemplazar la primera ocurrencia
-      QString vdirRoot = versionsDir();
-      int idx = vdirRoot.indexOf("/versions");
-      if (idx != -1) {
-        pdirPath = vdirRoot;
-        pdirPath.replace(idx, 9, "/profiles");
-      } else {
-        // Si no, usar el mismo padre y añadir 'profiles'
-        QDir parentDir(vdirRoot);
-        parentDir.cdUp();
-        pdirPath = QDir(parentDir.absolutePath()).filePath("profiles");
-      }
+  deleteVersions({versionPath}, deleteProfile);
+}
+
+void MinecraftManager::deleteVersions(const QStringList &versionPaths,
+                                      bool deleteProfile) {
+  StallWatchdog::OperationScope operation("delete");
+  qCDebug(lcVersions) << "Deleting versions:" << versionPaths
+                      << ", deleteProfile:" << deleteProfile;
+
+  // rename() a .trash es instantáneo; el borrado real (gigas con mundos y
+  // cachés) se hace en segundo plano, en un solo trabajo para todo el lote
+  QVariantList deletedList;
+  QStringList trashRoots;
+  for (const QString &versionPath : versionPaths) {
+    if (versionPath.isEmpty()) {
+      qCDebug(lcVersions) << "No version path provided.";
+      continue;
+    }
+    // Si se pasó únicamente el nombre (no contiene '/'), construir la ruta
+    // completa
+    QString vpath = versionPath;
+    if (!vpath.contains(QDir::separator()) && !vpath.startsWith("/")) {
+      qCDebug(lcVersions)
+          << "Interpreting versionPath as name only, constructing full path.";
+      vpath = QDir(versionsDir()).filePath(vpath);
     }
 
-    // Construir ruta del profile a borrar: pdirPath + folderName
-    QString folderName = QFileInfo(vpath).fileName();
-    QString profilePath = QDir(pdirPath).filePath(folderName);
-    QDir pdir(profilePath);
-    bool premoved = pdir.removeRecursively();
-    qDebug() << "[MinecraftManager] removeRecursively(profile:" << profilePath
-             << ") =>" << premoved;
-  }
+    const QString folderName = QFileInfo(vpath).fileName();
+    if (m_instances->liveForVersion(folderName)) {
+      qWarning() << "[MinecraftManager] deleteVersions: version is running:"
+                 << folderName;
+      continue;
+    }
 
-  emit availableVersionsChanged();
-  checkInstallation();
+    const QString versionTrash = TrashPurger::moveToTrash(vpath);
+    if (!versionTrash.isEmpty()) {
+      deletedList.append(vpath);
+      trashRoots.append(versionTrash);
+    }
 
-  QVariantList deletedList;
-  if (removed)
-    deletedList.append(vpath);
-  // include profile path in deleted list if it existed and was removed
-  // (we can't easily know profilePath here unless we recompute; recompute if
-  // deleteProfile)
-  if (deleteProfile) {
-    QString folderName = QFileInfo(vpath).fileName();
-    QString pdirRoot;
-    QByteArray env = qgetenv("MINECRAFT_PROFILES_DIR");
-    if (!env.isEmpty()) {
-      pdirRoot = QString::fromUtf8(env);
-    } else {
-      QString vdirRoot = versionsDir();
-      int idx = vdirRoot.indexOf("/versions");
-      if (idx != -1) {
-        pdirRoot = vdirRoot;
-        pdirRoot.replace(idx, 9, "/profiles");
-      } else {
-        QDir parentDir(vdirRoot);
-        parentDir.cdUp();
-        pdirRoot = QDir(parentDir.absolutePath()).filePath("profiles");
+    if (deleteProfile) {
+      const QString profilePath = QDir(profilesDir()).filePath(folderName);
+      if (QDir(profilePath).exists()) {
+        const QString profileTrash = TrashPurger::moveToTrash(profilePath);
+        if (!profileTrash.isEmpty()) {
+          deletedList.append(profilePath);
+          trashRoots.append(profileTrash);
+        }
       }
     }
-    QString profilePath = QDir(pdirRoot).filePath(folderName);
-    if (QDir(profilePath).exists())
-      deletedList.append(profilePath);
   }
+  m_trash->purge(trashRoots);
+
+  // Un único reescaneo para todo el lote (incluye checkInstallation)
+  const QVariantList availAfter = getAvailableVersions();
 
-  qDebug() << "[MinecraftManager] Deleted entries:" << deletedList;
+  qCDebug(lcVersions) << "[MinecraftManager] Deleted entries:" << deletedList;
   emit versionsDeleted(deletedList);
 
   // Recompute installedVersion after deletion so QML reflects current state
-  QVariantList availAfter = getAvailableVersions();
   QString newInstalled;
   if (!availAfter.isEmpty()) {
     QVariantMap first = availAfter.first().toMap();
@@ -438,7 +689,6 @@ void MinecraftManager::deleteVersion(const QString &versionPath,
   if (newInstalled != m_installedVersion) {
     m_installedVersion = newInstalled;
     emit installedVersionChanged();
-    emit availableVersionsChanged();
   }
 }
 
@@ -449,12 +699,11 @@ void MinecraftManager::installRequested(const QString &apkPath,
                                         bool useDefaultBackground,
                                         const QString &backgroundPath,
                                         const QString &tag) {
-  qDebug() << "[MinecraftManager] installRequested: apk=" << apkPath
-           << " name=" << name << " useDefaultIcon=" << useDefaultIcon
-           << " iconPath=" << iconPath
-           << " useDefaultBackground=" << useDefaultBackground
-           << " backgroundPath=" << backgroundPath
-           << " tag=" << tag;
+  qCDebug(lcInstall) << "[MinecraftManager] installRequested: apk=" << apkPath
+                     << " name=" << name << " useDefaultIcon=" << useDefaultIcon
+                     << " iconPath=" << iconPath << " useDefaultBackground="
+                     << useDefaultBackground << " backgroundPath="
+                     << backgroundPath << " tag=" << tag;
 
   // Si ya hay una instalación en curso, rechazar la nueva para evitar
   // estados inconsistentes (la UI QML ya debería evitarlo, pero es una
@@ -491,8 +740,9 @@ void MinecraftManager::installRequested(const QString &apkPath,
   QString existingVersionFolder = QDir(versionsDir()).filePath(name);
   QDir existingDir(existingVersionFolder);
   if (existingDir.exists()) {
-    qDebug() << "[MinecraftManager] installRequested: version already exists,"
-             << "treating as success for" << existingVersionFolder;
+    qCDebug(lcInstall)
+        << "[MinecraftManager] installRequested: version already exists,"
+        << "treating as success for" << existingVersionFolder;
     emit installSucceeded(existingVersionFolder);
     return;
   }
@@ -517,8 +767,9 @@ void MinecraftManager::installRequested(const QString &apkPath,
   if (m_pathManager) {
     ctx->stagedApk = m_pathManager->stageFileForExtraction(apkPath);
     if (!ctx->stagedApk.isEmpty()) {
-      qDebug() << "[MinecraftManager] Using staged APK for extraction:"
-               << ctx->stagedApk;
+      qCDebug(lcInstall)
+          << "[MinecraftManager] Using staged APK for extraction:"
+          << ctx->stagedApk;
       ctx->apkToUse = ctx->stagedApk;
     }
   }
@@ -549,8 +800,9 @@ void MinecraftManager::installRequested(const QString &apkPath,
       m_pathManager) {
     ctx->stagedIcon = m_pathManager->stageFileForExtraction(iconPath);
     if (!ctx->stagedIcon.isEmpty()) {
-      qDebug() << "[MinecraftManager] Using staged icon for later copy:"
-               << ctx->stagedIcon;
+      qCDebug(lcInstall)
+          << "[MinecraftManager] Using staged icon for later copy:"
+          << ctx->stagedIcon;
       ctx->iconToUse = ctx->stagedIcon;
     }
   }
@@ -559,8 +811,9 @@ void MinecraftManager::installRequested(const QString &apkPath,
     ctx->stagedBackground =
         m_pathManager->stageFileForExtraction(backgroundPath);
     if (!ctx->stagedBackground.isEmpty()) {
-      qDebug() << "[MinecraftManager] Using staged background for later copy:"
-               << ctx->stagedBackground;
+      qCDebug(lcInstall)
+          << "[MinecraftManager] Using staged background for later copy:"
+          << ctx->stagedBackground;
       ctx->bgToUse = ctx->stagedBackground;
     }
   }
@@ -585,6 +838,7 @@ void MinecraftManager::installRequested(const QString &apkPath,
   QFuture<QPair<bool, QString>> future =
       QtConcurrent::run([this, apkToUse = ctx->apkToUse,
                          versionName = ctx->name]() -> QPair<bool, QString> {
+        ProcessPriority::WorkerScope priority;
         MinecraftExtract extractor(m_pathManager);
         QString extractorErr;
         bool ok = extractor.extractApk(apkToUse, versionName, &extractorErr);
@@ -596,6 +850,7 @@ void MinecraftManager::installRequested(const QString &apkPath,
 
 void MinecraftManager::handleInstallCompletion(bool ok,
                                                const QString &extractorErr) {
+  StallWatchdog::OperationScope operation("install");
   InstallContext *ctx = m_currentInstall;
   if (!ctx) {
     qWarning() << "[MinecraftManager] handleInstallCompletion called without"
@@ -627,9 +882,10 @@ void MinecraftManager::handleInstallCompletion(bool ok,
     // versiones "fantasma".
     QDir vdirAttempt(versionFolderAttempt);
     if (vdirAttempt.exists()) {
-      qDebug() << "[MinecraftManager] Removing incomplete version folder due "
-                  "to extraction failure:"
-               << versionFolderAttempt;
+      qCWarning(lcInstall)
+          << "[MinecraftManager] Removing incomplete version folder due "
+             "to extraction failure:"
+          << versionFolderAttempt;
       bool removed = vdirAttempt.removeRecursively();
       if (!removed)
         qWarning()
@@ -646,16 +902,17 @@ void MinecraftManager::handleInstallCompletion(bool ok,
           return;
         QString clean = QDir::cleanPath(p);
         if (clean.startsWith(QDir(importsDir).absolutePath())) {
-          qDebug() << "[MinecraftManager] Removing staged file after failed "
-                      "extraction:"
-                   << clean;
+          qCWarning(lcInstall)
+              << "[MinecraftManager] Removing staged file after failed "
+                 "extraction:"
+              << clean;
           if (!QFile::remove(clean)) {
             qWarning() << "[MinecraftManager] Failed to remove staged file:"
                        << clean;
           }
         } else {
-          qDebug() << "[MinecraftManager] Not a staged file (skipping):"
-                   << clean;
+          qCDebug(lcInstall)
+              << "[MinecraftManager] Not a staged file (skipping):" << clean;
         }
       };
 
@@ -672,10 +929,12 @@ void MinecraftManager::handleInstallCompletion(bool ok,
       }
     }
 
-    qDebug() << "[MinecraftManager] installFailed: extraction failed and "
-                "cleanup attempted for version:"
-             << name;
-    qDebug() << "[MinecraftManager] extraction error message:" << extractorErr;
+    qCWarning(lcInstall)
+        << "[MinecraftManager] installFailed: extraction failed and "
+           "cleanup attempted for version:"
+        << name;
+    qCWarning(lcInstall) << "[MinecraftManager] extraction error message:"
+                         << extractorErr;
 
     delete m_currentInstall;
     m_currentInstall = nullptr;
@@ -687,8 +946,8 @@ void MinecraftManager::handleInstallCompletion(bool ok,
 
   // After extraction, the version folder should exist: versionsDir()/name
   QString versionFolder = QDir(versionsDir()).filePath(name);
-  qDebug() << "[MinecraftManager] versionFolder after extraction:"
-           << versionFolder;
+  qCDebug(lcInstall) << "[MinecraftManager] versionFolder after extraction:"
+                     << versionFolder;
   QDir vdir(versionFolder);
   if (!vdir.exists()) {
     qWarning() << "Expected version folder not found after extraction:"
@@ -702,15 +961,17 @@ void MinecraftManager::handleInstallCompletion(bool ok,
           return;
         QString clean = QDir::cleanPath(p);
         if (clean.startsWith(QDir(importsDir).absolutePath())) {
-          qDebug() << "[MinecraftManager] Removing staged file after missing"
-                      " version folder:" << clean;
+          qCWarning(lcInstall)
+              << "[MinecraftManager] Removing staged file after missing"
+                 " version folder:"
+              << clean;
           if (!QFile::remove(clean)) {
             qWarning()
                 << "[MinecraftManager] Failed to remove staged file:" << clean;
           }
         } else {
-          qDebug() << "[MinecraftManager] Not a staged file (skipping):"
-                   << clean;
+          qCDebug(lcInstall)
+              << "[MinecraftManager] Not a staged file (skipping):" << clean;
         }
       };
 
@@ -743,9 +1004,9 @@ void MinecraftManager::handleInstallCompletion(bool ok,
   // this installation as cancelled rather than succeeded. Roll back the
   // created version folder and emit installFailed with an appropriate reason.
   if (m_installCancelRequested) {
-    qDebug() << "[MinecraftManager] Installation was cancelled by user after"
-                " extraction. Rolling back version folder:"
-             << versionFolder;
+    qCDebug(lcInstall)
+        << "[MinecraftManager] Installation was cancelled by user after"
+           " extraction. Rolling back version folder:" << versionFolder;
 
     // Attempt to remove the created version folder to avoid keeping a
     // partially installed or unwanted version.
@@ -765,15 +1026,16 @@ void MinecraftManager::handleInstallCompletion(bool ok,
           return;
         QString clean = QDir::cleanPath(p);
         if (clean.startsWith(QDir(importsDir).absolutePath())) {
-          qDebug() << "[MinecraftManager] Removing staged file after cancel:"
-                   << clean;
+          qCDebug(lcInstall)
+              << "[MinecraftManager] Removing staged file after cancel:"
+              << clean;
           if (!QFile::remove(clean)) {
             qWarning() << "[MinecraftManager] Failed to remove staged file:"
                        << clean;
           }
         } else {
-          qDebug() << "[MinecraftManager] Not a staged file (skipping):"
-                   << clean;
+          qCDebug(lcInstall)
+              << "[MinecraftManager] Not a staged file (skipping):" << clean;
         }
       };
 
@@ -824,8 +1086,8 @@ void MinecraftManager::handleInstallCompletion(bool ok,
       QFile::remove(QDir(versionFolder).filePath(old));
 
     bool copied = QFile::copy(effectiveIconPath, destIcon);
-    qDebug() << "[MinecraftManager] copy icon" << effectiveIconPath << "->"
-             << destIcon << "=>" << copied;
+    qCDebug(lcInstall) << "[MinecraftManager] copy icon" << effectiveIconPath
+                       << "->" << destIcon << "=>" << copied;
     if (!copied)
       qWarning() << "Failed to copy icon to" << destIcon;
   }
@@ -852,8 +1114,8 @@ void MinecraftManager::handleInstallCompletion(bool ok,
       QFile::remove(QDir(versionFolder).filePath(old));
 
     bool copied = QFile::copy(effectiveBgPath, destBg);
-    qDebug() << "[MinecraftManager] copy background" << effectiveBgPath
-             << "->" << destBg << "=>" << copied;
+    qCDebug(lcInstall) << "[MinecraftManager] copy background"
+                       << effectiveBgPath << "->" << destBg << "=>" << copied;
     if (!copied)
       qWarning() << "Failed to copy background to" << destBg;
   }
@@ -867,7 +1129,7 @@ void MinecraftManager::handleInstallCompletion(bool ok,
       QTextStream out(&tagFile);
       out << tag;
       tagFile.close();
-      qDebug() << "[MinecraftManager] tag saved to" << tagFilePath;
+      qCDebug(lcInstall) << "[MinecraftManager] tag saved to" << tagFilePath;
     } else {
       qWarning() << "[MinecraftManager] failed to save tag to" << tagFilePath;
     }
@@ -878,8 +1140,8 @@ void MinecraftManager::handleInstallCompletion(bool ok,
   emit installedVersionChanged();
   emit availableVersionsChanged();
   checkInstallation();
-  qDebug() << "[MinecraftManager] installRequested completed for" << name
-           << "folder:" << versionFolder;
+  qCDebug(lcInstall) << "[MinecraftManager] installRequested completed for"
+                     << name << "folder:" << versionFolder;
 
   // Intentar limpiar archivos staged que se copiaron a dataDir/imports.
   if (m_pathManager) {
@@ -889,13 +1151,15 @@ void MinecraftManager::handleInstallCompletion(bool ok,
         return;
       QString clean = QDir::cleanPath(p);
       if (clean.startsWith(QDir(importsDir).absolutePath())) {
-        qDebug() << "[MinecraftManager] Removing staged file:" << clean;
+        qCDebug(lcInstall) << "[MinecraftManager] Removing staged file:"
+                           << clean;
         if (!QFile::remove(clean)) {
           qWarning() << "[MinecraftManager] Failed to remove staged file:"
                      << clean;
         }
       } else {
-        qDebug() << "[MinecraftManager] Not a staged file (skipping):" << clean;
+        qCDebug(lcInstall) << "[MinecraftManager] Not a staged file (skipping):"
+                           << clean;
       }
     };
 
@@ -932,8 +1196,9 @@ void MinecraftManager::importSelected(const QString &filePath,
                                       const QString &versionPath,
                                       bool useShared, bool useNvidia,
                                       bool useZink, bool useMangohud) {
-  qDebug() << "MinecraftManager::importSelected file:" << filePath
-           << "type:" << type << "version:" << versionPath;
+  StallWatchdog::OperationScope operation("import");
+  qCDebug(lcGame) << "MinecraftManager::importSelected file:" << filePath
+                  << "type:" << type << "version:" << versionPath;
 
   if (versionPath.isEmpty()) {
     qWarning() << "importSelected: versionPath empty";
@@ -1009,8 +1274,8 @@ void MinecraftManager::importSelected(const QString &filePath,
     args << "-o" << fileToUse << "-d" << destDir;
 
     QProcess proc;
-    qDebug() << "importSelected: extracting addon with" << unzipBin << args
-             << "into" << destDir;
+    qCDebug(lcGame) << "importSelected: extracting addon with" << unzipBin
+                    << args << "into" << destDir;
     proc.start(unzipBin, args);
     if (!proc.waitForStarted(5000)) {
       qWarning() << "importSelected: failed to start unzip for addon";
@@ -1035,7 +1300,8 @@ void MinecraftManager::importSelected(const QString &filePath,
       return;
     }
 
-    qDebug() << "importSelected: addon extracted successfully to" << destDir;
+    qCDebug(lcGame) << "importSelected: addon extracted successfully to"
+                    << destDir;
     emit importSucceeded(versionPath, fileToUse);
 
     // If we staged the file, try to remove it after extraction
@@ -1047,29 +1313,331 @@ void MinecraftManager::importSelected(const QString &filePath,
     return;
   }
 
-  // Default path: delegate import to the launcher (worlds / other types)
-  MinecraftLaunch launcher(m_pathManager);
-  bool ok = launcher.importFile(fullVersionPath, fileToUse, useShared,
-                                useNvidia, useZink, useMangohud);
+  // Default path: delegate import to the launcher (worlds / other types).
+  // The result arrives asynchronously through MinecraftLaunch::importStarted /
+  // importFailed (connected in the constructor).
+  // The per-version preset applies here too; the flags only force options on.
+  LaunchPreset preset = m_launcher->loadPreset(fullVersionPath);
+  if (useShared)
+    preset.profileMode = QStringLiteral("shared");
+  if (useZink)
+    preset.gpu = QStringLiteral("zink");
+  else if (useNvidia)
+    preset.gpu = QStringLiteral("nvidia");
+  if (useMangohud)
+    preset.mangohud = true;
+  bool ok = m_launcher->importFile(fullVersionPath, fileToUse, preset);
   if (!ok) {
     qWarning() << "importSelected: launcher failed to start";
     emit importFailed(versionPath, fileToUse,
                       "Failed to start client for import");
     return;
   }
+}
 
-  qDebug() << "importSelected: import started for" << fileToUse << "into"
-           << versionPath;
-  emit importSucceeded(versionPath, fileToUse);
+double MinecraftManager::shaderCacheSizeMb(const QString &versionPath) const {
+  const QString dir = m_launcher->shaderCacheDir(resolveVersionPath(versionPath));
+  if (versionPath.isEmpty() || dir.isEmpty())
+    return 0.0;
+  return ShaderCache::size(dir) / (1024.0 * 1024.0);
+}
 
-  // If we staged the file, try to remove it after starting the import
-  if (!staged.isEmpty()) {
-    if (!m_pathManager->removeStagedFile(staged)) {
-      qWarning() << "importSelected: failed to remove staged file:" << staged;
-    } else {
-      qDebug() << "importSelected: removed staged file:" << staged;
+bool MinecraftManager::pruneShaderCache(const QString &versionPath, int maxMb) {
+  const QString fullVersionPath = resolveVersionPath(versionPath);
+  const QString versionName = QFileInfo(fullVersionPath).fileName();
+  const QString dir = m_launcher->shaderCacheDir(fullVersionPath);
+  if (versionPath.isEmpty() || dir.isEmpty() || !QDir(dir).exists())
+    return false;
+  if (m_instances->liveForVersion(versionName)) {
+    qWarning() << "pruneShaderCache: version is running:" << versionName;
+    return false;
+  }
+  if (maxMb < 0)
+    maxMb = m_launcher->loadPreset(fullVersionPath).shaderCacheMaxMb;
+  const qint64 maxBytes = qint64(maxMb) * 1024 * 1024;
+
+  auto *watcher = new QFutureWatcher<QPair<qint64, qint64>>(this);
+  connect(watcher, &QFutureWatcherBase::finished, this,
+          [this, watcher, versionName]() {
+            const QPair<qint64, qint64> result = watcher->result();
+            watcher->deleteLater();
+            emit shaderCachePruned(versionName,
+                                   result.first / (1024.0 * 1024.0),
+                                   result.second / (1024.0 * 1024.0));
+          });
+  watcher->setFuture(QtConcurrent::run([dir, maxBytes]() {
+    ProcessPriority::WorkerScope priority;
+    const qint64 freed = ShaderCache::prune(dir, maxBytes);
+    return qMakePair(freed, ShaderCache::size(dir));
+  }));
+  return true;
+}
+
+QVariantMap MinecraftManager::getLaunchPreset(const QString &versionPath) const {
+  return m_launcher->loadPreset(resolveVersionPath(versionPath))
+      .toJson()
+      .toVariantMap();
+}
+
+bool MinecraftManager::setLaunchPreset(const QString &versionPath,
+                                       const QVariantMap &preset) {
+  const QString fullVersionPath = resolveVersionPath(versionPath);
+  if (versionPath.isEmpty() || !QDir(fullVersionPath).exists()) {
+    qWarning() << "setLaunchPreset: version path does not exist:"
+               << fullVersionPath;
+    return false;
+  }
+  // Partir del preset guardado para que un mapa parcial sólo cambie sus
+  // claves
+  QJsonObject merged = m_launcher->loadPreset(fullVersionPath).toJson();
+  const QJsonObject changes = QJsonObject::fromVariantMap(preset);
+  for (auto it = changes.constBegin(); it != changes.constEnd(); ++it)
+    merged.insert(it.key(), it.value());
+  const bool ok = m_launcher->savePreset(fullVersionPath,
+                                         LaunchPreset::fromJson(merged));
+  if (ok)
+    emit launchPresetChanged(QFileInfo(fullVersionPath).fileName());
+  return ok;
+}
+
+QString MinecraftManager::resolveVersionPath(const QString &versionPath) const {
+  QFileInfo vfi(versionPath);
+  if (!vfi.isAbsolute() && !versionPath.contains(QDir::separator()))
+    return QDir(versionsDir()).filePath(versionPath);
+  return versionPath;
+}
+
+QString MinecraftManager::worldsDir(const QString &versionPath) const {
+  if (!m_pathManager)
+    return QString();
+  // <dataDir>/games/com.mojang/minecraftWorlds, con el mismo directorio de
+  // datos que recibe el cliente al lanzarlo (el compartido con
+  // profileMode "shared")
+  const QString fullVersionPath = resolveVersionPath(versionPath);
+  const QString dataDir = m_launcher->dataDir(
+      fullVersionPath, m_launcher->loadPreset(fullVersionPath));
+  if (dataDir.isEmpty())
+    return QString();
+  return QDir(dataDir).filePath("games/com.mojang/minecraftWorlds");
+}
+
+bool MinecraftManager::isPlainName(const QString &name) {
+  return !name.isEmpty() && name != QLatin1String(".") &&
+         name != QLatin1String("..") && !name.contains(QLatin1Char('/')) &&
+         !name.contains(QLatin1Char('\\'));
+}
+
+QString MinecraftManager::resolveWorldPath(const QString &versionPath,
+                                           const QString &worldId) const {
+  // worldId llega desde QML: nunca debe salir de minecraftWorlds
+  const QString root = worldsDir(versionPath);
+  if (root.isEmpty() || !isPlainName(worldId))
+    return QString();
+  return QDir(root).filePath(worldId);
+}
+
+QVariantList MinecraftManager::listWorlds(const QString &versionPath) const {
+  QVariantList list;
+  if (versionPath.isEmpty())
+    return list;
+
+  const QString root = worldsDir(versionPath);
+  QDir dir(root);
+  if (root.isEmpty() || !dir.exists())
+    return list;
+
+  const QFileInfoList entries =
+      dir.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Time);
+  for (const QFileInfo &fi : entries) {
+    QVariantMap m;
+    m.insert("id", fi.fileName());
+    m.insert("path", fi.absoluteFilePath());
+    m.insert("lastModified", fi.lastModified().toMSecsSinceEpoch());
+
+    // levelname.txt contiene el nombre visible del mundo
+    QString name = fi.fileName();
+    QFile levelName(QDir(fi.absoluteFilePath()).filePath("levelname.txt"));
+    if (levelName.open(QIODevice::ReadOnly | QIODevice::Text)) {
+      const QString read = QString::fromUtf8(levelName.readAll()).trimmed();
+      if (!read.isEmpty())
+        name = read;
     }
+    m.insert("name", name);
+    list.append(m);
+  }
+  return list;
+}
+
+bool MinecraftManager::exportWorld(const QString &versionPath,
+                                   const QString &worldId,
+                                   const QString &destPath,
+                                   int compressionLevel) {
+  qCDebug(lcWorlds) << "[MinecraftManager] exportWorld version:" << versionPath
+                    << "world:" << worldId << "dest:" << destPath << "level:"
+                    << compressionLevel;
+
+  QString dest = destPath;
+  if (dest.startsWith("file://"))
+    dest = QUrl(dest).toLocalFile();
+
+  const QString worldPath = resolveWorldPath(versionPath, worldId);
+  if (worldPath.isEmpty() || !QDir(worldPath).exists()) {
+    qWarning() << "exportWorld: world not found:" << worldId;
+    emit worldExportFailed(worldPath, dest, "World not found");
+    return false;
+  }
+  if (dest.isEmpty()) {
+    emit worldExportFailed(worldPath, dest, "No destination selected");
+    return false;
+  }
+  if (!dest.endsWith(".mcworld", Qt::CaseInsensitive))
+    dest += QStringLiteral(".mcworld");
+
+  if (!m_worldBackup->exportWorld(worldPath, dest,
+                                  qBound(0, compressionLevel, 9))) {
+    emit worldExportFailed(worldPath, dest,
+                           "Another export is already in progress");
+    return false;
   }
+  return true;
+}
+
+QString MinecraftManager::worldBackupStore(const QString &versionPath,
+                                           const QString &worldId) const {
+  if (!m_pathManager)
+    return QString();
+  const QString versionName =
+      QFileInfo(resolveVersionPath(versionPath)).fileName();
+  return QDir(m_pathManager->backupsDir())
+      .filePath(versionName + QLatin1Char('/') + worldId);
+}
+
+bool MinecraftManager::worldInUse(const QString &worldPath) const {
+  // El juego mantiene abiertos los archivos LevelDB de los mundos de su
+  // directorio de datos; un snapshot en ese momento no sería consistente
+  const QString world = QDir::cleanPath(worldPath) + QLatin1Char('/');
+  for (GameInstance *inst : m_instances->liveInstances()) {
+    const QString dataDir = inst->dataDir();
+    if (!dataDir.isEmpty() &&
+        world.startsWith(QDir::cleanPath(dataDir) + QLatin1Char('/')))
+      return true;
+  }
+  return false;
+}
+
+bool MinecraftManager::backupWorld(const QString &versionPath,
+                                   const QString &worldId) {
+  qCDebug(lcWorlds) << "[MinecraftManager] backupWorld version:" << versionPath
+                    << "world:" << worldId;
+  const QString worldPath = resolveWorldPath(versionPath, worldId);
+  if (worldPath.isEmpty() || !QDir(worldPath).exists()) {
+    qWarning() << "backupWorld: world not found:" << worldId;
+    emit worldBackupFinished(QStringList(), false, "World not found");
+    return false;
+  }
+  if (worldInUse(worldPath)) {
+    emit worldBackupFinished(QStringList(), false,
+                             "Stop the game before backing up this world");
+    return false;
+  }
+
+  QList<WorldBackup::BackupTarget> targets;
+  targets.append(qMakePair(worldPath, worldBackupStore(versionPath, worldId)));
+  if (!m_worldBackup->backupWorlds(targets)) {
+    emit worldBackupFinished(QStringList(), false,
+                             "Another backup operation is in progress");
+    return false;
+  }
+  return true;
+}
+
+bool MinecraftManager::backupAllWorlds() {
+  QList<WorldBackup::BackupTarget> targets;
+  // Las versiones con profileMode "shared" ven los mismos mundos: cada uno
+  // se copia una sola vez
+  QSet<QString> seen;
+  int inUse = 0;
+  for (const QVariant &v : m_availableVersions) {
+    const QString versionName = v.toMap().value("name").toString();
+    for (const QVariant &w : listWorlds(versionName)) {
+      const QVariantMap world = w.toMap();
+      const QString path = world.value("path").toString();
+      if (seen.contains(path))
+        continue;
+      seen.insert(path);
+      // Los mundos de las instancias en marcha se omiten; el resto se copia
+      if (worldInUse(path)) {
+        ++inUse;
+        continue;
+      }
+      targets.append(qMakePair(
+          path, worldBackupStore(versionName, world.value("id").toString())));
+    }
+  }
+  qCDebug(lcWorlds) << "[MinecraftManager] backupAllWorlds:" << targets.size()
+                    << "worlds," << inUse << "skipped while in use";
+
+  if (targets.isEmpty()) {
+    if (inUse > 0) {
+      emit worldBackupFinished(QStringList(), false,
+                               "Stop the game before backing up its worlds");
+      return false;
+    }
+    emit worldBackupFinished(QStringList(), true, QString());
+    return true;
+  }
+  if (!m_worldBackup->backupWorlds(targets)) {
+    emit worldBackupFinished(QStringList(), false,
+                             "Another backup operation is in progress");
+    return false;
+  }
+  return true;
+}
+
+QVariantList MinecraftManager::listWorldSnapshots(const QString &versionPath,
+                                                  const QString &worldId) const {
+  if (versionPath.isEmpty() || !isPlainName(worldId))
+    return QVariantList();
+  return WorldBackup::listSnapshots(worldBackupStore(versionPath, worldId));
+}
+
+bool MinecraftManager::restoreWorldSnapshot(const QString &versionPath,
+                                            const QString &worldId,
+                                            const QString &snapshotId) {
+  qCDebug(lcWorlds) << "[MinecraftManager] restoreWorldSnapshot version:"
+                    << versionPath << "world:" << worldId << "snapshot:"
+                    << snapshotId;
+  const QString worldPath = resolveWorldPath(versionPath, worldId);
+  if (worldPath.isEmpty() || !isPlainName(snapshotId)) {
+    emit worldRestoreFinished(worldPath, snapshotId, false,
+                              "No world or snapshot selected");
+    return false;
+  }
+  if (isRunning()) {
+    // El juego mantiene abiertos los archivos LevelDB del mundo
+    emit worldRestoreFinished(worldPath, snapshotId, false,
+                              "Stop the game before restoring a world");
+    return false;
+  }
+  if (!m_worldBackup->restoreSnapshot(worldBackupStore(versionPath, worldId),
+                                      snapshotId, worldPath)) {
+    emit worldRestoreFinished(worldPath, snapshotId, false,
+                              "Another backup operation is in progress");
+    return false;
+  }
+  return true;
+}
+
+bool MinecraftManager::trashBusy() const { return m_trash->isBusy(); }
+
+double MinecraftManager::trashProgress() const { return m_trash->progress(); }
+
+bool MinecraftManager::worldBackupBusy() const {
+  return m_worldBackup && m_worldBackup->isBusy();
+}
+
+double MinecraftManager::worldBackupProgress() const {
+  return m_worldBackup ? m_worldBackup->progress() : 0.0;
 }
 
 QString MinecraftManager::getLauncherVersion() const {
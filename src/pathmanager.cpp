@@ -1,4 +1,5 @@
 #include "../include/pathmanager.h"
+#include "../include/logcategories.h"
 
 #include <QCoreApplication>
 #include <QDebug>
@@ -84,16 +85,17 @@ QString resolveExecutableCandidate(const QString &configuredPath,
 
 PathManager::PathManager(QObject *parent) : QObject(parent) {
   computePaths();
-  qDebug() << "[PathManager] computed paths:";
-  qDebug() << "  isFlatpak=" << m_isFlatpak;
-  qDebug() << "  homeDir=" << m_homeDir;
-  qDebug() << "  dataDir=" << m_dataDir;
-  qDebug() << "  launcherDir=" << m_launcherDir;
-  qDebug() << "  versionsDir=" << m_versionsDir;
-  qDebug() << "  profilesDir=" << m_profilesDir;
-  qDebug() << "  logsDir=" << m_logsDir;
-  qDebug() << "  extractor=" << m_mcpelauncherExtract;
-  qDebug() << "  client=" << m_mcpelauncherClient;
+  qCDebug(lcPaths) << "[PathManager] computed paths:";
+  qCDebug(lcPaths) << "  isFlatpak=" << m_isFlatpak;
+  qCDebug(lcPaths) << "  homeDir=" << m_homeDir;
+  qCDebug(lcPaths) << "  dataDir=" << m_dataDir;
+  qCDebug(lcPaths) << "  launcherDir=" << m_launcherDir;
+  qCDebug(lcPaths) << "  versionsDir=" << m_versionsDir;
+  qCDebug(lcPaths) << "  profilesDir=" << m_profilesDir;
+  qCDebug(lcPaths) << "  logsDir=" << m_logsDir;
+  qCDebug(lcPaths) << "  backupsDir=" << m_backupsDir;
+  qCDebug(lcPaths) << "  extractor=" << m_mcpelauncherExtract;
+  qCDebug(lcPaths) << "  client=" << m_mcpelauncherClient;
 
   ensurePathsExist();
 }
@@ -106,7 +108,8 @@ void PathManager::computePaths() {
   QByteArray envDataDir = qgetenv("MINECRAFT_DATA_DIR");
   if (!envDataDir.isEmpty()) {
     m_dataDir = QString::fromUtf8(envDataDir);
-    qDebug() << "[PathManager] Using MINECRAFT_DATA_DIR override:" << m_dataDir;
+    qCDebug(lcPaths) << "[PathManager] Using MINECRAFT_DATA_DIR override:"
+                     << m_dataDir;
   }
   // 2. Modo terminal/Portátil (Si existe carpeta 'data' local o estamos en
   // 'build')
@@ -119,7 +122,7 @@ void PathManager::computePaths() {
 
     if (isDev && !m_isFlatpak) {
       m_dataDir = QDir(appDirPath).filePath("data");
-      qDebug()
+      qCDebug(lcPaths)
           << "[PathManager] Terminal/Dev mode detected, using local data dir:"
           << m_dataDir;
     } else if (m_isFlatpak) {
@@ -134,8 +137,8 @@ void PathManager::computePaths() {
       // Aseguramos que termine en /minecraft para consistencia con los datos
       // existentes del usuario
       m_dataDir = QDir::cleanPath(base + "/minecraft");
-      qDebug() << "[PathManager] Flatpak detected, using data dir:"
-               << m_dataDir;
+      qCDebug(lcPaths) << "[PathManager] Flatpak detected, using data dir:"
+                       << m_dataDir;
     } else {
       // 4. Nativo (Carpeta de datos estándar del sistema)
       m_dataDir =
@@ -143,8 +146,8 @@ void PathManager::computePaths() {
       if (m_dataDir.isEmpty()) {
         m_dataDir = QDir::cleanPath(m_homeDir + "/.minecraft-launcher");
       }
-      qDebug() << "[PathManager] Native mode, using AppDataLocation:"
-               << m_dataDir;
+      qCDebug(lcPaths) << "[PathManager] Native mode, using AppDataLocation:"
+                       << m_dataDir;
     }
   }
 
@@ -154,6 +157,7 @@ void PathManager::computePaths() {
   m_versionsDir = QDir::cleanPath(m_launcherDir + "/versions");
   m_profilesDir = QDir::cleanPath(m_launcherDir + "/profiles");
   m_logsDir = QDir::cleanPath(m_launcherDir + "/logs");
+  m_backupsDir = QDir::cleanPath(m_launcherDir + "/backups");
   m_configFile = QDir::cleanPath(m_launcherDir + "/config.json");
 
   if (m_isFlatpak) {
@@ -168,14 +172,14 @@ void PathManager::computePaths() {
   QByteArray envExtract = qgetenv("MCPELAUNCHER_EXTRACT");
   if (!envExtract.isEmpty()) {
     m_mcpelauncherExtract = QString::fromUtf8(envExtract);
-    qDebug() << "[PathManager] MCPELAUNCHER_EXTRACT override:"
-             << m_mcpelauncherExtract;
+    qCDebug(lcPaths) << "[PathManager] MCPELAUNCHER_EXTRACT override:"
+                     << m_mcpelauncherExtract;
   }
   QByteArray envClient = qgetenv("MCPELAUNCHER_CLIENT");
   if (!envClient.isEmpty()) {
     m_mcpelauncherClient = QString::fromUtf8(envClient);
-    qDebug() << "[PathManager] MCPELAUNCHER_CLIENT override:"
-             << m_mcpelauncherClient;
+    qCDebug(lcPaths) << "[PathManager] MCPELAUNCHER_CLIENT override:"
+                     << m_mcpelauncherClient;
   }
 
   // Normalize paths so AppImage and relative overrides don't depend on stale
@@ -187,10 +191,10 @@ void PathManager::computePaths() {
       resolveExecutableCandidate(m_mcpelauncherClient,
                                  QStringLiteral("mcpelauncher-client"));
 
-  qDebug() << "[PathManager] Resolved extractor binary to:"
-           << m_mcpelauncherExtract;
-  qDebug() << "[PathManager] Resolved client binary to:"
-           << m_mcpelauncherClient;
+  qCDebug(lcPaths) << "[PathManager] Resolved extractor binary to:"
+                   << m_mcpelauncherExtract;
+  qCDebug(lcPaths) << "[PathManager] Resolved client binary to:"
+                   << m_mcpelauncherClient;
 }
 
 bool PathManager::isFlatpak() const { return m_isFlatpak; }
@@ -200,6 +204,7 @@ QString PathManager::launcherDir() const { return m_launcherDir; }
 QString PathManager::versionsDir() const { return m_versionsDir; }
 QString PathManager::profilesDir() const { return m_profilesDir; }
 QString PathManager::logsDir() const { return m_logsDir; }
+QString PathManager::backupsDir() const { return m_backupsDir; }
 QString PathManager::configFile() const { return m_configFile; }
 QString PathManager::mcpelauncherExtract() const {
   return m_mcpelauncherExtract;
@@ -212,18 +217,21 @@ void PathManager::ensurePathsExist() const {
   d.mkpath(m_versionsDir);
   d.mkpath(m_profilesDir);
   d.mkpath(m_logsDir);
+  d.mkpath(m_backupsDir);
   // Ensure optional asset dirs exist as well
   QString backgrounds = QDir(m_dataDir).filePath("backgrounds");
   QString icons = QDir(m_dataDir).filePath("icons");
   d.mkpath(backgrounds);
   d.mkpath(icons);
-  qDebug() << "[PathManager] ensurePathsExist created (or verified) dirs:";
-  qDebug() << "  launcherDir=" << m_launcherDir;
-  qDebug() << "  versionsDir=" << m_versionsDir;
-  qDebug() << "  profilesDir=" << m_profilesDir;
-  qDebug() << "  logsDir=" << m_logsDir;
-  qDebug() << "  backgrounds=" << backgrounds;
-  qDebug() << "  icons=" << icons;
+  qCDebug(lcPaths)
+      << "[PathManager] ensurePathsExist created (or verified) dirs:";
+  qCDebug(lcPaths) << "  launcherDir=" << m_launcherDir;
+  qCDebug(lcPaths) << "  versionsDir=" << m_versionsDir;
+  qCDebug(lcPaths) << "  profilesDir=" << m_profilesDir;
+  qCDebug(lcPaths) << "  logsDir=" << m_logsDir;
+  qCDebug(lcPaths) << "  backupsDir=" << m_backupsDir;
+  qCDebug(lcPaths) << "  backgrounds=" << backgrounds;
+  qCDebug(lcPaths) << "  icons=" << icons;
 }
 
 QString PathManager::stageFileForExtraction(const QString &originalPath) const {
@@ -251,18 +259,18 @@ QString PathManager::stageFileForExtraction(const QString &originalPath) const {
           << path;
       return QString();
     }
-    qDebug() << "[PathManager] stageFileForExtraction: source not visible to "
-                "QFileInfo(), attempting portal fallback copy:"
-             << path;
+    qCDebug(lcPaths)
+        << "[PathManager] stageFileForExtraction: source not visible to "
+           "QFileInfo(), attempting portal fallback copy:" << path;
   }
 
   // If the file is already inside versionsDir or dataDir, return as-is
   QString abs = QDir::cleanPath(srcInfo.absoluteFilePath());
   if (abs.startsWith(QDir(m_versionsDir).absolutePath()) ||
       abs.startsWith(QDir(m_dataDir).absolutePath())) {
-    qDebug() << "[PathManager] stageFileForExtraction: file already in data "
-                "area, returning original:"
-             << abs;
+    qCDebug(lcPaths)
+        << "[PathManager] stageFileForExtraction: file already in data "
+           "area, returning original:" << abs;
     return abs;
   }
 
@@ -303,7 +311,7 @@ QString PathManager::stageFileForExtraction(const QString &originalPath) const {
         out.close();
         in.close();
         if (written == data.size()) {
-          qDebug()
+          qCDebug(lcPaths)
               << "[PathManager] staged file for extraction via stream fallback:"
               << abs << "->" << dest;
           return QDir::cleanPath(dest);
@@ -322,8 +330,8 @@ QString PathManager::stageFileForExtraction(const QString &originalPath) const {
     return QString();
   }
 
-  qDebug() << "[PathManager] staged file for extraction:" << abs << "->"
-           << dest;
+  qCDebug(lcPaths) << "[PathManager] staged file for extraction:" << abs << "->"
+                   << dest;
   return QDir::cleanPath(dest);
 }
 
@@ -450,6 +458,7 @@ QString PathManager::saveThemeToProfile(const QString &profileName,
     return QString();
   }
 
-  qDebug() << "[PathManager] saved custom theme:" << src << "->" << dest;
+  qCDebug(lcPaths) << "[PathManager] saved custom theme:" << src << "->"
+                   << dest;
   return QDir::cleanPath(dest);
 }
@@ -0,0 +1,202 @@
+#include "../include/processpriority.h"
+#include "../include/logcategories.h"
+
+#include <QDebug>
+
+#include <atomic>
+#include <cerrno>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace ProcessPriority {
+
+namespace {
+
+// De linux/ioprio.h, que no todas las distribuciones instalan
+constexpr int kIoprioWhoProcess = 1;
+constexpr int kIoprioClassShift = 13;
+
+int ioprioValue(IoClass ioClass, int level) {
+  return (int(ioClass) << kIoprioClassShift) | qBound(0, level, 7);
+}
+
+int ioprioGet(qint64 tid) {
+  return int(::syscall(SYS_ioprio_get, kIoprioWhoProcess, pid_t(tid)));
+}
+
+bool ioprioSet(qint64 tid, int value) {
+  return ::syscall(SYS_ioprio_set, kIoprioWhoProcess, pid_t(tid), value) == 0;
+}
+
+std::atomic_bool g_gameActive{false};
+std::atomic_bool g_idleWorkers{true};
+
+QList<qint64> childrenOf(qint64 pid) {
+  // /proc/<pid>/task/<tid>/children lista los hijos creados por cada hilo.
+  // Se lee con read() directamente: el muestreo de telemetría lo llama en
+  // cada muestra.
+  QList<qint64> children;
+  for (qint64 tid : tasksOf(pid)) {
+    const QByteArray path = "/proc/" + QByteArray::number(pid) + "/task/" +
+                            QByteArray::number(tid) + "/children";
+    const int fd = ::open(path.constData(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+      continue;
+    QByteArray text;
+    char buf[1024];
+    ssize_t n;
+    while ((n = ::read(fd, buf, sizeof(buf))) > 0)
+      text.append(buf, int(n));
+    ::close(fd);
+    for (const QByteArray &child : text.split(' ')) {
+      bool ok = false;
+      const qint64 cpid = child.trimmed().toLongLong(&ok);
+      if (ok)
+        children.append(cpid);
+    }
+  }
+  return children;
+}
+
+} // namespace
+
+QList<qint64> tasksOf(qint64 pid) {
+  QList<qint64> tids;
+  const QByteArray path = "/proc/" + QByteArray::number(pid) + "/task";
+  DIR *dir = ::opendir(path.constData());
+  if (!dir)
+    return tids;
+  while (dirent *entry = ::readdir(dir)) {
+    bool ok = false;
+    const qint64 tid = QByteArray(entry->d_name).toLongLong(&ok);
+    if (ok)
+      tids.append(tid);
+  }
+  ::closedir(dir);
+  return tids;
+}
+
+QList<qint64> processTree(qint64 pid) {
+  QList<qint64> pids{pid};
+  for (int i = 0; i < pids.size(); ++i)
+    pids.append(childrenOf(pids.at(i)));
+  return pids;
+}
+
+IoClass ioClassFromString(const QString &name) {
+  if (name == QLatin1String("realtime"))
+    return IoClass::Realtime;
+  if (name == QLatin1String("best-effort"))
+    return IoClass::BestEffort;
+  if (name == QLatin1String("idle"))
+    return IoClass::Idle;
+  return IoClass::None;
+}
+
+QString ioClassToString(IoClass ioClass) {
+  switch (ioClass) {
+  case IoClass::Realtime:
+    return QStringLiteral("realtime");
+  case IoClass::BestEffort:
+    return QStringLiteral("best-effort");
+  case IoClass::Idle:
+    return QStringLiteral("idle");
+  case IoClass::None:
+    break;
+  }
+  return QStringLiteral("none");
+}
+
+bool applyToProcessTree(qint64 pid, const Settings &settings) {
+  if (pid <= 0 || settings.isDefault())
+    return true;
+
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  for (int cpu : settings.cpus)
+    if (cpu >= 0 && cpu < CPU_SETSIZE)
+      CPU_SET(cpu, &mask);
+  const bool setAffinity = CPU_COUNT(&mask) > 0;
+
+  bool ok = true;
+  const QList<qint64> pids = processTree(pid);
+  for (qint64 member : pids) {
+    for (qint64 tid : tasksOf(member)) {
+      if (setAffinity && ::sched_setaffinity(pid_t(tid), sizeof(mask), &mask)) {
+        qWarning() << "[ProcessPriority] sched_setaffinity failed for" << tid
+                   << qt_error_string(errno);
+        ok = false;
+      }
+      // En Linux setpriority(PRIO_PROCESS, tid) afecta sólo a ese hilo
+      if (settings.nice != 0 &&
+          ::setpriority(PRIO_PROCESS, id_t(tid), settings.nice)) {
+        qWarning() << "[ProcessPriority] setpriority" << settings.nice
+                   << "failed for" << tid << qt_error_string(errno);
+        ok = false;
+      }
+      if (settings.ioClass != IoClass::None &&
+          !ioprioSet(tid, ioprioValue(settings.ioClass, settings.ioLevel))) {
+        qWarning() << "[ProcessPriority] ioprio_set failed for" << tid
+                   << qt_error_string(errno);
+        ok = false;
+      }
+    }
+  }
+  qCDebug(lcGame) << "[ProcessPriority] applied to" << pids.size()
+                  << "process(es) of" << pid << "cpus:" << settings.cpus
+                  << "nice:" << settings.nice << "io:"
+                  << ioClassToString(settings.ioClass) << settings.ioLevel;
+  return ok;
+}
+
+void setGameSessionActive(bool active) { g_gameActive.store(active); }
+
+void setIdleWorkersEnabled(bool enabled) { g_idleWorkers.store(enabled); }
+
+bool idleWorkersEnabled() { return g_idleWorkers.load(); }
+
+bool workersShouldIdle() { return g_gameActive.load() && g_idleWorkers.load(); }
+
+WorkerScope::WorkerScope(Mode mode) {
+  if (mode != Mode::Always && !workersShouldIdle())
+    return;
+
+  sched_param param{};
+  if (::pthread_getschedparam(::pthread_self(), &m_policy, &param) != 0)
+    return;
+
+  // Salir de SCHED_IDLE exige poder subir el nice del hilo (RLIMIT_NICE o
+  // CAP_SYS_NICE). Sin ese permiso el hilo del pool se quedaría en idle
+  // para siempre, así que entonces se usa SCHED_BATCH, que sí es reversible.
+  static const bool canLeaveIdle = []() {
+    rlimit lim{};
+    return ::geteuid() == 0 ||
+           (::getrlimit(RLIMIT_NICE, &lim) == 0 && lim.rlim_cur >= 20);
+  }();
+
+  param.sched_priority = 0;
+  if (::pthread_setschedparam(::pthread_self(),
+                              canLeaveIdle ? SCHED_IDLE : SCHED_BATCH,
+                              &param) != 0)
+    return;
+  m_ioprio = ioprioGet(0);
+  ioprioSet(0, ioprioValue(IoClass::Idle, 7));
+  m_lowered = true;
+}
+
+WorkerScope::~WorkerScope() {
+  if (!m_lowered)
+    return;
+  sched_param param{};
+  ::pthread_setschedparam(::pthread_self(), m_policy, &param);
+  if (m_ioprio >= 0)
+    ioprioSet(0, m_ioprio);
+}
+
+} // namespace ProcessPriority
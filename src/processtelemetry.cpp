@@ -0,0 +1,311 @@
+#include "../include/processtelemetry.h"
+#include "../include/logcategories.h"
+#include "../include/processpriority.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QTimer>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+// Los archivos de /proc no tienen tamaño, así que se leen hasta EOF con
+// read() directamente: es más barato que pasar por QFile en cada muestra.
+QByteArray readProcFile(const QByteArray &path) {
+  QByteArray out;
+  const int fd = ::open(path.constData(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return out;
+  char buf[4096];
+  for (;;) {
+    const ssize_t n = ::read(fd, buf, sizeof(buf));
+    if (n <= 0)
+      break;
+    out.append(buf, int(n));
+  }
+  ::close(fd);
+  return out;
+}
+
+QByteArray procPath(qint64 pid, const char *file) {
+  return QByteArray("/proc/") + QByteArray::number(pid) + '/' + file;
+}
+
+struct StatFields {
+  qint64 ticks = 0; // utime + stime
+  bool ok = false;
+};
+
+StatFields parseStat(const QByteArray &stat) {
+  StatFields f;
+  // El campo comm va entre paréntesis y puede contener espacios; el resto
+  // empieza tras el último ')'. rest[0] es el campo 3 (state).
+  const int close = stat.lastIndexOf(')');
+  if (close < 0)
+    return f;
+  const QList<QByteArray> rest = stat.mid(close + 2).split(' ');
+  if (rest.size() < 13)
+    return f;
+  f.ticks = rest.at(11).toLongLong() + rest.at(12).toLongLong();
+  f.ok = true;
+  return f;
+}
+
+// Valor numérico de una línea "Clave:   123 kB" de status/io
+qint64 keyedValue(const QByteArray &text, const QByteArray &key) {
+  int pos = text.startsWith(key) ? 0 : text.indexOf('\n' + key);
+  if (pos < 0)
+    return 0;
+  if (text.at(pos) == '\n')
+    ++pos;
+  pos += key.size();
+  int end = text.indexOf('\n', pos);
+  if (end < 0)
+    end = text.size();
+  const QByteArray value = text.mid(pos, end - pos).trimmed();
+  const int space = value.indexOf(' ');
+  return (space < 0 ? value : value.left(space)).toLongLong();
+}
+
+const qint64 kTicksPerSecond = ::sysconf(_SC_CLK_TCK);
+const qint64 kPageSize = ::sysconf(_SC_PAGESIZE);
+constexpr double kMb = 1024.0 * 1024.0;
+
+} // namespace
+
+ProcessTelemetry::ProcessTelemetry(QObject *parent)
+    : QAbstractListModel(parent) {
+  m_samples.resize(m_capacity);
+  m_timer = new QTimer(this);
+  m_timer->setInterval(m_intervalMs);
+  connect(m_timer, &QTimer::timeout, this, &ProcessTelemetry::sampleNow);
+}
+
+int ProcessTelemetry::rowCount(const QModelIndex &parent) const {
+  if (parent.isValid())
+    return 0;
+  return m_count;
+}
+
+const ProcessTelemetry::Sample &ProcessTelemetry::at(int row) const {
+  return m_samples[(m_head + row) % m_capacity];
+}
+
+QVariant ProcessTelemetry::data(const QModelIndex &index, int role) const {
+  if (!index.isValid() || index.row() < 0 || index.row() >= m_count)
+    return QVariant();
+
+  const Sample &s = at(index.row());
+  switch (role) {
+  case TimeRole:
+    return s.timestamp;
+  case CpuRole:
+    return s.cpuPercent;
+  case RssRole:
+    return s.rssMb;
+  case SwapRole:
+    return s.swapMb;
+  case ThreadsRole:
+    return s.threads;
+  case ProcessCountRole:
+    return s.processCount;
+  case ReadRateRole:
+    return s.readMbPerSec;
+  case WriteRateRole:
+    return s.writeMbPerSec;
+  default:
+    return QVariant();
+  }
+}
+
+QHash<int, QByteArray> ProcessTelemetry::roleNames() const {
+  QHash<int, QByteArray> roles;
+  roles[TimeRole] = "timestamp";
+  roles[CpuRole] = "cpu";
+  roles[RssRole] = "rss";
+  roles[SwapRole] = "swap";
+  roles[ThreadsRole] = "threads";
+  roles[ProcessCountRole] = "processCount";
+  roles[ReadRateRole] = "readRate";
+  roles[WriteRateRole] = "writeRate";
+  return roles;
+}
+
+void ProcessTelemetry::start(qint64 pid) {
+  qCDebug(lcGame) << "[ProcessTelemetry] sampling pid" << pid << "every"
+                  << m_intervalMs << "ms";
+  clear();
+  m_pid = pid;
+  m_prev.clear();
+  m_peakRssMb = 0.0;
+  m_lastSampleMs = 0;
+  emit activeChanged();
+  sampleNow();
+  m_timer->start();
+}
+
+void ProcessTelemetry::stop() {
+  m_timer->stop();
+  if (m_pid == 0)
+    return;
+  qCDebug(lcGame) << "[ProcessTelemetry] stopped sampling pid" << m_pid
+                  << "peak RSS MB:" << m_peakRssMb;
+  m_pid = 0;
+  emit activeChanged();
+}
+
+void ProcessTelemetry::clear() {
+  beginResetModel();
+  m_head = 0;
+  m_count = 0;
+  endResetModel();
+  m_last = Sample();
+  emit sampled();
+}
+
+void ProcessTelemetry::setIntervalMs(int ms) {
+  ms = qBound(100, ms, 60000);
+  if (m_intervalMs == ms)
+    return;
+  m_intervalMs = ms;
+  m_timer->setInterval(ms);
+  emit intervalMsChanged();
+}
+
+void ProcessTelemetry::setCapacity(int capacity) {
+  capacity = qBound(10, capacity, 100000);
+  if (m_capacity == capacity)
+    return;
+
+  // Conservar las muestras más recientes que quepan
+  beginResetModel();
+  const int keep = qMin(m_count, capacity);
+  QVector<Sample> resized(capacity);
+  for (int i = 0; i < keep; ++i)
+    resized[i] = at(m_count - keep + i);
+  m_samples = resized;
+  m_capacity = capacity;
+  m_head = 0;
+  m_count = keep;
+  endResetModel();
+  emit capacityChanged();
+}
+
+void ProcessTelemetry::append(const Sample &sample) {
+  if (m_count == m_capacity) {
+    beginRemoveRows(QModelIndex(), 0, 0);
+    m_head = (m_head + 1) % m_capacity;
+    --m_count;
+    endRemoveRows();
+  }
+  beginInsertRows(QModelIndex(), m_count, m_count);
+  m_samples[(m_head + m_count) % m_capacity] = sample;
+  ++m_count;
+  endInsertRows();
+}
+
+void ProcessTelemetry::sampleNow() {
+  if (m_pid <= 0)
+    return;
+
+  const qint64 now = QDateTime::currentMSecsSinceEpoch();
+  const double dt = m_lastSampleMs > 0 ? (now - m_lastSampleMs) / 1000.0 : 0.0;
+
+  Sample s;
+  s.timestamp = now;
+  qint64 deltaTicks = 0;
+  qint64 deltaRead = 0;
+  qint64 deltaWrite = 0;
+  qint64 rssPages = 0;
+  qint64 swapKb = 0;
+
+  QHash<qint64, ProcCounters> current;
+  // Sólo el juego y sus descendientes, sin recorrer todo /proc
+  const QList<qint64> tree = ProcessPriority::processTree(m_pid);
+  for (qint64 pid : tree) {
+    const StatFields stat = parseStat(readProcFile(procPath(pid, "stat")));
+    if (!stat.ok)
+      continue; // terminó entre el escaneo y la lectura
+
+    ProcCounters c;
+    c.cpuTicks = stat.ticks;
+
+    const QByteArray statm = readProcFile(procPath(pid, "statm"));
+    const QList<QByteArray> pages = statm.split(' ');
+    if (pages.size() > 1)
+      rssPages += pages.at(1).toLongLong();
+
+    // io puede no ser legible (ptrace_scope); en ese caso cuenta como 0
+    const QByteArray io = readProcFile(procPath(pid, "io"));
+    c.readBytes = keyedValue(io, "read_bytes:");
+    c.writeBytes = keyedValue(io, "write_bytes:");
+
+    const QByteArray status = readProcFile(procPath(pid, "status"));
+    s.threads += int(keyedValue(status, "Threads:"));
+    swapKb += keyedValue(status, "VmSwap:");
+    ++s.processCount;
+
+    // Los procesos nuevos no aportan delta hasta su segunda muestra
+    auto prev = m_prev.constFind(pid);
+    if (prev != m_prev.constEnd()) {
+      deltaTicks += qMax<qint64>(0, c.cpuTicks - prev->cpuTicks);
+      deltaRead += qMax<qint64>(0, c.readBytes - prev->readBytes);
+      deltaWrite += qMax<qint64>(0, c.writeBytes - prev->writeBytes);
+    }
+    current.insert(pid, c);
+  }
+
+  if (current.isEmpty())
+    return; // el proceso ya no existe; finished() llamará a stop()
+
+  m_prev = current;
+  m_lastSampleMs = now;
+
+  s.rssMb = double(rssPages * kPageSize) / kMb;
+  s.swapMb = double(swapKb) / 1024.0;
+  if (dt > 0.0) {
+    s.cpuPercent = double(deltaTicks) / double(kTicksPerSecond) / dt * 100.0;
+    s.readMbPerSec = double(deltaRead) / kMb / dt;
+    s.writeMbPerSec = double(deltaWrite) / kMb / dt;
+  }
+
+  m_last = s;
+  m_peakRssMb = qMax(m_peakRssMb, s.rssMb);
+  append(s);
+  emit sampled();
+}
+
+double ProcessTelemetry::fieldOf(const Sample &s, const QString &field) {
+  if (field == QLatin1String("cpu"))
+    return s.cpuPercent;
+  if (field == QLatin1String("rss"))
+    return s.rssMb;
+  if (field == QLatin1String("swap"))
+    return s.swapMb;
+  if (field == QLatin1String("threads"))
+    return s.threads;
+  if (field == QLatin1String("processes"))
+    return s.processCount;
+  if (field == QLatin1String("read"))
+    return s.readMbPerSec;
+  if (field == QLatin1String("write"))
+    return s.writeMbPerSec;
+  return 0.0;
+}
+
+QVariantList ProcessTelemetry::series(const QString &field) const {
+  QVariantList values;
+  values.reserve(m_count);
+  for (int i = 0; i < m_count; ++i)
+    values.append(fieldOf(at(i), field));
+  return values;
+}
+
+double ProcessTelemetry::maxOf(const QString &field) const {
+  double max = 0.0;
+  for (int i = 0; i < m_count; ++i)
+    max = qMax(max, fieldOf(at(i), field));
+  return max;
+}
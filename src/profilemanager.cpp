@@ -1,4 +1,5 @@
 #include "../include/profilemanager.h"
+#include "../include/logcategories.h"
 #include <QDebug>
 #include <QDateTime>
 
@@ -32,7 +33,7 @@ void ProfileManager::setCurrentProfile(const QString &profile)
     if (m_currentProfile != profile) {
         m_currentProfile = profile;
         emit currentProfileChanged(profile);
-        qDebug() << "[ProfileManager] Perfil cambiado a:" << profile;
+        qCDebug(lcProfiles) << "[ProfileManager] Perfil cambiado a:" << profile;
     }
 }
 
@@ -65,7 +66,7 @@ void ProfileManager::addProfile(const QString &name, const QString &version)
     // Guardar inmediatamente
     saveProfiles();
     
-    qDebug() << "[ProfileManager] Perfil agregado:" << name;
+    qCDebug(lcProfiles) << "[ProfileManager] Perfil agregado:" << name;
 }
 
 void ProfileManager::addProfileWithSettings(const QString &name, const QString &language, 
@@ -100,8 +101,8 @@ void ProfileManager::addProfileWithSettings(const QString &name, const QString &
     // Guardar inmediatamente
     saveProfiles();
     
-    qDebug() << "[ProfileManager] Perfil agregado con configuración:" << name 
-             << "Language:" << language << "Theme:" << theme << "Scale:" << scale;
+    qCDebug(lcProfiles) << "[ProfileManager] Perfil agregado con configuración:" << name 
+                        << "Language:" << language << "Theme:" << theme << "Scale:" << scale;
 }
 
 void ProfileManager::removeProfile(const QString &name)
@@ -111,7 +112,7 @@ void ProfileManager::removeProfile(const QString &name)
         if (profile["name"].toString() == name) {
             m_profiles.removeAt(i);
             emit profilesChanged();
-            qDebug() << "[ProfileManager] Perfil eliminado:" << name;
+            qCDebug(lcProfiles) << "[ProfileManager] Perfil eliminado:" << name;
             
             // Si era el perfil actual, cambiar a Default
             if (m_currentProfile == name) {
@@ -147,7 +148,7 @@ void ProfileManager::updateProfile(const QString &name, const QVariantMap &data)
             }
             m_profiles[i] = profile;
             emit profilesChanged();
-            qDebug() << "[ProfileManager] Perfil actualizado:" << name;
+            qCDebug(lcProfiles) << "[ProfileManager] Perfil actualizado:" << name;
             return;
         }
     }
@@ -185,10 +186,10 @@ void ProfileManager::loadProfiles()
         
         m_profiles.append(profile);
         
-        qDebug() << "[ProfileManager] Perfil cargado:" << profileName 
-                 << "Language:" << profile["language"] 
-                 << "Theme:" << profile["theme"] 
-                 << "Scale:" << profile["scale"];
+        qCDebug(lcProfiles) << "[ProfileManager] Perfil cargado:" << profileName 
+                            << "Language:" << profile["language"]
+                            << "Theme:" << profile["theme"]
+                            << "Scale:" << profile["scale"];
     }
     m_settings->endArray();
     
@@ -200,18 +201,18 @@ void ProfileManager::loadProfiles()
     // Cargar perfil actual
     m_currentProfile = m_settings->value("currentProfile", "Default").toString();
     
-    qDebug() << "[ProfileManager] Cargados" << m_profiles.size() << "perfiles";
+    qCDebug(lcProfiles) << "[ProfileManager] Cargados" << m_profiles.size() << "perfiles";
 }
 
 void ProfileManager::reloadProfiles()
 {
-    qDebug() << "[ProfileManager] Iniciando reloadProfiles()";
+    qCDebug(lcProfiles) << "[ProfileManager] Iniciando reloadProfiles()";
     QString currentProfileName = m_currentProfile;
     loadProfiles();
     emit profilesChanged();
     // Emitir cambio de perfil actual para que los componentes se actualicen
     emit currentProfileChanged(currentProfileName);
-    qDebug() << "[ProfileManager] Perfiles recargados exitosamente";
+    qCDebug(lcProfiles) << "[ProfileManager] Perfiles recargados exitosamente";
 }
 
 void ProfileManager::saveProfiles()
@@ -0,0 +1,78 @@
+#include "../include/shadercache.h"
+#include "../include/logcategories.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QVector>
+
+#include <algorithm>
+
+namespace {
+struct Entry {
+  QString path;
+  qint64 size = 0;
+  qint64 lastUse = 0;
+};
+
+// Archivos que los drivers usan para llevar la cuenta de la caché
+bool isIndexFile(const QString &name) {
+  return name == QLatin1String("index") ||
+         name.endsWith(QLatin1String(".toc")) ||
+         name.endsWith(QLatin1String(".lock"));
+}
+} // namespace
+
+namespace ShaderCache {
+
+qint64 size(const QString &dir) {
+  qint64 total = 0;
+  QDirIterator it(dir, QDir::Files | QDir::Hidden | QDir::NoSymLinks,
+                  QDirIterator::Subdirectories);
+  while (it.hasNext()) {
+    it.next();
+    total += it.fileInfo().size();
+  }
+  return total;
+}
+
+qint64 prune(const QString &dir, qint64 maxBytes) {
+  QVector<Entry> entries;
+  qint64 total = 0;
+  QDirIterator it(dir, QDir::Files | QDir::Hidden | QDir::NoSymLinks,
+                  QDirIterator::Subdirectories);
+  while (it.hasNext()) {
+    it.next();
+    const QFileInfo fi = it.fileInfo();
+    total += fi.size();
+    if (isIndexFile(fi.fileName()))
+      continue;
+    // Con noatime/relatime la fecha de acceso puede ser antigua; la más
+    // reciente de las dos es la mejor aproximación al último uso
+    const qint64 lastUse =
+        qMax(fi.lastRead().toMSecsSinceEpoch(),
+             fi.lastModified().toMSecsSinceEpoch());
+    entries.append({fi.absoluteFilePath(), fi.size(), lastUse});
+  }
+  if (total <= maxBytes)
+    return 0;
+
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry &a, const Entry &b) { return a.lastUse < b.lastUse; });
+
+  qint64 freed = 0;
+  for (const Entry &e : entries) {
+    if (total - freed <= maxBytes)
+      break;
+    if (QFile::remove(e.path))
+      freed += e.size;
+  }
+  qCDebug(lcVersions) << "[ShaderCache] pruned" << dir << "freed" << freed
+                      << "bytes," << (total - freed) << "left";
+  return freed;
+}
+
+} // namespace ShaderCache
@@ -0,0 +1,154 @@
+#include "../include/stallwatchdog.h"
+#include "../include/logcategories.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QThread>
+#include <QTimer>
+#include <QVariantMap>
+
+#include <algorithm>
+#include <chrono>
+
+namespace {
+// Operación instrumentada en curso en el hilo de la GUI (o nullptr)
+std::atomic<const char *> g_operation{nullptr};
+
+bool onGuiThread() {
+  const QCoreApplication *app = QCoreApplication::instance();
+  return app && QThread::currentThread() == app->thread();
+}
+} // namespace
+
+StallWatchdog::OperationScope::OperationScope(const char *name)
+    : m_active(onGuiThread()) {
+  if (m_active)
+    m_previous = g_operation.exchange(name, std::memory_order_relaxed);
+}
+
+StallWatchdog::OperationScope::~OperationScope() {
+  if (m_active)
+    g_operation.store(m_previous, std::memory_order_relaxed);
+}
+
+StallWatchdog::StallWatchdog(QObject *parent) : QObject(parent) {
+  m_lastBeat.store(monotonicMs());
+  m_beatTimer = new QTimer(this);
+  m_beatTimer->setTimerType(Qt::PreciseTimer);
+  m_beatTimer->setInterval(kBeatMs);
+  connect(m_beatTimer, &QTimer::timeout, this, &StallWatchdog::beat);
+  m_beatTimer->start();
+  m_thread = std::thread([this]() { run(); });
+}
+
+StallWatchdog::~StallWatchdog() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_cv.notify_one();
+  if (m_thread.joinable())
+    m_thread.join();
+}
+
+qint64 StallWatchdog::monotonicMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void StallWatchdog::setThresholdMs(int ms) {
+  ms = qBound(kBeatMs * 2, ms, 10000);
+  if (m_thresholdMs.exchange(ms) == ms)
+    return;
+  emit thresholdChanged();
+}
+
+void StallWatchdog::beat() {
+  const qint64 now = monotonicMs();
+  const qint64 previous = m_lastBeat.exchange(now);
+  // El propio intervalo no cuenta como parada
+  const qint64 stalled = now - previous - kBeatMs;
+  const char *operation = m_stallOperation.exchange(nullptr);
+  if (stalled >= m_thresholdMs.load())
+    recordStall(stalled, operation);
+}
+
+void StallWatchdog::run() {
+  // Muestrea varias veces por umbral para ver la operación aunque la
+  // parada sea corta
+  bool hangReported = false;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      const int interval = qMax(10, m_thresholdMs.load() / 4);
+      if (m_cv.wait_for(lock, std::chrono::milliseconds(interval),
+                        [this]() { return m_stop; }))
+        return;
+    }
+
+    const qint64 lag = monotonicMs() - m_lastBeat.load() - kBeatMs;
+    if (lag < m_thresholdMs.load()) {
+      hangReported = false;
+      continue;
+    }
+    // La operación más interna vista durante la parada
+    if (const char *op = g_operation.load(std::memory_order_relaxed))
+      m_stallOperation.store(op);
+    if (!hangReported && lag >= kHangReportMs) {
+      hangReported = true;
+      const char *op = m_stallOperation.load();
+      qCWarning(lcUi) << "[StallWatchdog] GUI thread blocked for" << lag
+                      << "ms so far, during" << (op ? op : "unknown");
+    }
+  }
+}
+
+void StallWatchdog::recordStall(qint64 durationMs, const char *operation) {
+  const QString op = operation ? QString::fromLatin1(operation)
+                               : QStringLiteral("unknown");
+  qCWarning(lcUi) << "[StallWatchdog] GUI thread stalled" << durationMs
+                  << "ms during" << op;
+
+  int bucket = 0;
+  while (bucket < kBucketCount - 1 && durationMs >= kBucketMs[bucket])
+    ++bucket;
+  ++m_buckets[bucket];
+  ++m_stallCount;
+
+  QVariantMap entry;
+  entry["operation"] = op;
+  entry["durationMs"] = durationMs;
+  entry["at"] = QDateTime::currentMSecsSinceEpoch();
+  m_recent.prepend(entry);
+  if (m_recent.size() > kMaxRecent)
+    m_recent.removeLast();
+  emit stallsChanged();
+}
+
+QVariantList StallWatchdog::histogram() const {
+  QVariantList list;
+  for (int i = 0; i < kBucketCount; ++i) {
+    QVariantMap entry;
+    if (i == 0)
+      entry["label"] = QStringLiteral("<%1 ms").arg(kBucketMs[0]);
+    else if (i == kBucketCount - 1)
+      entry["label"] = QStringLiteral(">%1 ms").arg(kBucketMs[i - 1]);
+    else
+      entry["label"] =
+          QStringLiteral("%1-%2 ms").arg(kBucketMs[i - 1]).arg(kBucketMs[i]);
+    entry["count"] = m_buckets[i];
+    list.append(entry);
+  }
+  return list;
+}
+
+QVariantList StallWatchdog::recentStalls() const { return m_recent; }
+
+void StallWatchdog::reset() {
+  m_stallCount = 0;
+  std::fill(std::begin(m_buckets), std::end(m_buckets), 0);
+  m_recent.clear();
+  emit stallsChanged();
+}
@@ -1,4 +1,5 @@
 #include "../include/thememanager.h"
+#include "../include/logcategories.h"
 
 #include <QDebug>
 #include <QFile>
@@ -151,7 +152,7 @@ bool ThemeManager::loadFromFile(const QString &path) {
   m_colors = base;
   m_currentSource = localPath;
   emit themeChanged();
-  qDebug() << "[ThemeManager] Tema cargado desde archivo:" << localPath;
+  qCDebug(lcUi) << "[ThemeManager] Tema cargado desde archivo:" << localPath;
   return true;
 }
 
@@ -178,7 +179,7 @@ bool ThemeManager::saveBundledDarkTemplateTo(const QString &destinationPath) {
     return false;
   }
   dst.close();
-  qDebug() << "[ThemeManager] Plantilla dark guardada en:" << localPath;
+  qCDebug(lcUi) << "[ThemeManager] Plantilla dark guardada en:" << localPath;
   return true;
 }
 
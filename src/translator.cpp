@@ -1,4 +1,5 @@
 #include "translator.h"
+#include "logcategories.h"
 #include <QGuiApplication>
 #include <QProcess>
 #include <QFile>
@@ -143,7 +144,7 @@ bool compileTsToQm(const QString& tsPath, const QString& qmPath) {
     }
 
     QProcess process;
-    qDebug() << "Compilando TS a QM con lrelease:" << tsPath << "->" << qmPath;
+    qCDebug(lcUi) << "Compilando TS a QM con lrelease:" << tsPath << "->" << qmPath;
     process.start(lrelease, QStringList() << tsPath << "-qm" << qmPath);
 
     if (!process.waitForStarted()) {
@@ -0,0 +1,172 @@
+#include "../include/trashpurger.h"
+#include "../include/processpriority.h"
+#include "../include/progressreporter.h"
+#include "../include/logcategories.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrentRun>
+
+TrashPurger::TrashPurger(QObject *parent) : QObject(parent) {}
+
+TrashPurger::~TrashPurger() {
+  // Lo que falte se purga en el siguiente arranque
+  if (m_cancel)
+    m_cancel->store(true);
+  m_future.waitForFinished();
+}
+
+QString TrashPurger::moveToTrash(const QString &path) {
+  const QFileInfo fi(path);
+  if (path.isEmpty() || !fi.exists())
+    return QString();
+
+  // Junto a la carpeta original: mismo sistema de archivos, así que rename()
+  // es atómico e inmediato aunque la carpeta ocupe gigas
+  const QString trashRoot = QDir(fi.absolutePath()).filePath(kTrashDirName);
+  if (!QDir().mkpath(trashRoot)) {
+    qWarning() << "[TrashPurger] cannot create" << trashRoot;
+    return QString();
+  }
+  const QString target = QDir(trashRoot).filePath(
+      QStringLiteral("%1.%2")
+          .arg(fi.fileName())
+          .arg(QDateTime::currentMSecsSinceEpoch()));
+  if (!QDir().rename(fi.absoluteFilePath(), target)) {
+    qWarning() << "[TrashPurger] cannot move" << path << "to" << target;
+    return QString();
+  }
+  qCDebug(lcVersions) << "[TrashPurger] moved" << path << "->" << target;
+  return trashRoot;
+}
+
+void TrashPurger::purge(const QStringList &trashRoots) {
+  for (const QString &root : trashRoots)
+    if (!root.isEmpty() && !m_pending.contains(root))
+      m_pending.append(root);
+  if (!m_busy)
+    startPending();
+}
+
+void TrashPurger::setProgress(double progress) {
+  if (qFuzzyCompare(m_progress + 1.0, progress + 1.0))
+    return;
+  m_progress = progress;
+  emit progressChanged();
+}
+
+void TrashPurger::startPending() {
+  if (m_pending.isEmpty())
+    return;
+  const QStringList roots = m_pending;
+  m_pending.clear();
+
+  // Se fija aquí, en el hilo de la GUI (el mismo que llama a moveToTrash),
+  // qué entradas se purgan. El trabajo borra cada una por separado y nunca
+  // toca la raíz .trash, así que un moveToTrash posterior no compite con él.
+  QStringList entries;
+  for (const QString &root : roots) {
+    const QDir dir(root);
+    for (const QString &name :
+         dir.entryList(QDir::AllEntries | QDir::NoDotAndDotDot |
+                       QDir::Hidden | QDir::System))
+      entries.append(dir.filePath(name));
+  }
+
+  m_busy = true;
+  emit busyChanged();
+  setProgress(0.0);
+
+  auto cancelled = std::make_shared<std::atomic_bool>(false);
+  m_cancel = cancelled;
+
+  const auto progressFn = throttledProgress(this, &TrashPurger::setProgress);
+
+  auto *watcher = new QFutureWatcher<Result>(this);
+  connect(watcher, &QFutureWatcherBase::finished, this,
+          [this, watcher, roots]() {
+    const Result result = watcher->result();
+    watcher->deleteLater();
+    m_cancel.reset();
+    // rmdir sólo borra la raíz si quedó vacía; aquí no puede coincidir con
+    // un moveToTrash
+    for (const QString &root : roots)
+      QDir().rmdir(root);
+    setProgress(1.0);
+    m_busy = false;
+    emit busyChanged();
+    emit purgeFinished(result.freedBytes, result.cancelled);
+    startPending();
+  });
+  m_future = QtConcurrent::run([entries, progressFn, cancelled]() {
+    return run(entries, progressFn, cancelled);
+  });
+  watcher->setFuture(m_future);
+}
+
+TrashPurger::Result
+TrashPurger::run(const QStringList &entries,
+                 const std::function<void(double)> &progressFn,
+                 const std::shared_ptr<std::atomic_bool> &cancelled) {
+  // Borrar nunca es urgente: prioridad baja aunque no haya juego abierto
+  ProcessPriority::WorkerScope priority(
+      ProcessPriority::WorkerScope::Mode::Always);
+  Result result;
+
+  // Primera pasada sólo para contar: el progreso va por archivos, no por
+  // bytes, porque borrar cuesta lo mismo sea cual sea el tamaño
+  const auto filters = QDir::Files | QDir::Hidden | QDir::System;
+  qint64 total = 0;
+  for (const QString &entry : entries) {
+    const QFileInfo fi(entry);
+    if (!fi.isDir() || fi.isSymLink()) {
+      ++total;
+      continue;
+    }
+    QDirIterator it(entry, filters, QDirIterator::Subdirectories);
+    while (it.hasNext() && !cancelled->load()) {
+      it.next();
+      ++total;
+    }
+  }
+
+  qint64 done = 0;
+  auto removeFile = [&](const QString &path, qint64 size) {
+    if (QFile::remove(path))
+      result.freedBytes += size;
+    ++done;
+    if (total > 0)
+      progressFn(double(done) / total);
+  };
+  for (const QString &entry : entries) {
+    if (cancelled->load()) {
+      result.cancelled = true;
+      return result;
+    }
+    const QFileInfo fi(entry);
+    if (!fi.isDir() || fi.isSymLink()) {
+      removeFile(entry, fi.size());
+      continue;
+    }
+    QDirIterator it(entry, filters, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+      if (cancelled->load()) {
+        result.cancelled = true;
+        return result;
+      }
+      it.next();
+      removeFile(it.filePath(), it.fileInfo().size());
+    }
+    // Quedan sólo directorios vacíos (y lo que no se pudo borrar)
+    QDir(entry).removeRecursively();
+  }
+  qCDebug(lcVersions) << "[TrashPurger] purged" << done << "files,"
+                      << result.freedBytes << "bytes from" << entries.size()
+                      << "entries";
+  return result;
+}
@@ -0,0 +1,190 @@
+#include "../include/versionprefetcher.h"
+#include "../include/processpriority.h"
+#include "../include/logcategories.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QTimer>
+#include <QVector>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <algorithm>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+// readahead() bloquea hasta leer el rango, así que se trocea para poder
+// cancelar entre bloques
+constexpr qint64 kChunkBytes = 8 * 1024 * 1024;
+// Archivos pequeños no compensan: el cliente los lee igualmente rápido
+constexpr qint64 kMinFileBytes = 256 * 1024;
+
+// No desalojar de la caché lo que está usando el resto del sistema: como
+// mucho la mitad de la memoria disponible
+qint64 availableMemoryBytes() {
+  QFile meminfo(QStringLiteral("/proc/meminfo"));
+  if (!meminfo.open(QIODevice::ReadOnly))
+    return -1;
+  while (!meminfo.atEnd()) {
+    const QByteArray line = meminfo.readLine();
+    if (line.startsWith("MemAvailable:"))
+      return line.mid(13).trimmed().split(' ').first().toLongLong() * 1024;
+  }
+  return -1;
+}
+
+} // namespace
+
+VersionPrefetcher::VersionPrefetcher(QObject *parent) : QObject(parent) {
+  m_debounce = new QTimer(this);
+  m_debounce->setSingleShot(true);
+  m_debounce->setInterval(kDebounceMs);
+  connect(m_debounce, &QTimer::timeout, this,
+          &VersionPrefetcher::startPending);
+}
+
+VersionPrefetcher::~VersionPrefetcher() { cancel(); }
+
+void VersionPrefetcher::setBudgetMb(int mb) {
+  mb = qMax(0, mb);
+  if (m_budgetMb == mb)
+    return;
+  m_budgetMb = mb;
+  emit budgetMbChanged();
+}
+
+void VersionPrefetcher::prefetch(const QString &versionDir) {
+  if (versionDir.isEmpty() || m_budgetMb == 0)
+    return;
+  const qint64 now = QDateTime::currentMSecsSinceEpoch();
+  if (versionDir == m_lastDir && now - m_lastDoneMs < kRepeatWindowMs)
+    return;
+  m_pending = versionDir;
+  m_debounce->start();
+}
+
+void VersionPrefetcher::cancel() {
+  m_debounce->stop();
+  m_pending.clear();
+  if (m_cancel)
+    m_cancel->store(true);
+}
+
+void VersionPrefetcher::startPending() {
+  const QString dir = m_pending;
+  m_pending.clear();
+  if (dir.isEmpty())
+    return;
+  // Ya en marcha para la misma versión
+  if (m_running > 0 && dir == m_lastDir && m_cancel && !m_cancel->load())
+    return;
+
+  // Sólo una precarga útil a la vez: la anterior se abandona
+  if (m_cancel)
+    m_cancel->store(true);
+  auto cancelled = std::make_shared<std::atomic_bool>(false);
+  m_cancel = cancelled;
+  m_lastDir = dir;
+  m_lastDoneMs = 0;
+
+  qint64 budget = qint64(m_budgetMb) * 1024 * 1024;
+  const qint64 available = availableMemoryBytes();
+  if (available > 0)
+    budget = qMin(budget, available / 2);
+
+  ++m_running;
+  if (m_running == 1)
+    emit busyChanged();
+
+  auto *watcher = new QFutureWatcher<Result>(this);
+  connect(watcher, &QFutureWatcher<Result>::finished, this,
+          [this, watcher, dir, cancelled]() {
+            const Result r = watcher->result();
+            watcher->deleteLater();
+            qCDebug(lcVersions) << "[VersionPrefetcher]" << dir << "prefetched"
+                                << r.bytes / (1024 * 1024) << "MB in"
+                                << r.elapsedMs << "ms"
+                                << (r.cancelled ? "(cancelled)" : "");
+            if (!r.cancelled && dir == m_lastDir)
+              m_lastDoneMs = QDateTime::currentMSecsSinceEpoch();
+            if (m_cancel == cancelled)
+              m_cancel.reset();
+            --m_running;
+            if (m_running == 0)
+              emit busyChanged();
+            emit prefetchFinished(dir, r.bytes, r.elapsedMs, r.cancelled);
+          });
+  watcher->setFuture(QtConcurrent::run(&VersionPrefetcher::run, dir, budget,
+                                       cancelled));
+}
+
+VersionPrefetcher::Result
+VersionPrefetcher::run(const QString &versionDir, qint64 budgetBytes,
+                       const std::shared_ptr<std::atomic_bool> &cancelled) {
+  ProcessPriority::WorkerScope priority;
+  Result result;
+  QElapsedTimer timer;
+  timer.start();
+
+  struct Candidate {
+    QString path;
+    qint64 size;
+  };
+  QVector<Candidate> files;
+  QDirIterator it(versionDir, QDir::Files | QDir::NoSymLinks,
+                  QDirIterator::Subdirectories);
+  while (it.hasNext()) {
+    it.next();
+    const qint64 size = it.fileInfo().size();
+    if (size >= kMinFileBytes)
+      files.append({it.filePath(), size});
+  }
+
+  // Las bibliotecas nativas primero (las carga el cliente antes que nada) y,
+  // dentro de cada grupo, de mayor a menor
+  std::sort(files.begin(), files.end(),
+            [](const Candidate &a, const Candidate &b) {
+              const bool aLib = a.path.endsWith(QLatin1String(".so"));
+              const bool bLib = b.path.endsWith(QLatin1String(".so"));
+              if (aLib != bLib)
+                return aLib;
+              return a.size > b.size;
+            });
+
+  for (const Candidate &file : files) {
+    if (cancelled->load()) {
+      result.cancelled = true;
+      break;
+    }
+    if (result.bytes >= budgetBytes)
+      break;
+
+    const QByteArray path = QFile::encodeName(file.path);
+    const int fd = ::open(path.constData(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+      continue;
+
+    const qint64 length = qMin(file.size, budgetBytes - result.bytes);
+    ::posix_fadvise(fd, 0, length, POSIX_FADV_WILLNEED);
+    for (qint64 offset = 0; offset < length; offset += kChunkBytes) {
+      if (cancelled->load()) {
+        result.cancelled = true;
+        break;
+      }
+      const qint64 chunk = qMin(kChunkBytes, length - offset);
+      ::readahead(fd, offset, size_t(chunk));
+      result.bytes += chunk;
+    }
+    ::close(fd);
+  }
+
+  result.elapsedMs = timer.elapsed();
+  return result;
+}
@@ -0,0 +1,802 @@
+#include "../include/worldbackup.h"
+#include "../include/processpriority.h"
+#include "../include/progressreporter.h"
+#include "../include/logcategories.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QThread>
+#include <QVector>
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <zip.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace {
+
+struct ExportEntry {
+  QString absPath;
+  QString zipName;
+  qint64 size = 0;
+};
+
+struct ExportShard {
+  QString tempPath;
+  QVector<ExportEntry> entries;
+  qint64 bytes = 0;
+  std::atomic<int> permille{0};
+  QString error;
+};
+
+struct ExportJob {
+  std::vector<ExportShard> shards;
+  qint64 totalBytes = 0;
+  int level = 6;
+  std::function<void(double)> progressFn;
+  const std::atomic_bool *cancelled = nullptr;
+
+  bool isCancelled() const { return cancelled && cancelled->load(); }
+
+  // La fase de compresión ocupa el 90% de la barra; la fusión el resto.
+  void reportCompression() {
+    if (!progressFn)
+      return;
+    double done = 0.0;
+    for (const ExportShard &s : shards)
+      done += double(s.bytes) * s.permille.load() / 1000.0;
+    progressFn(totalBytes > 0 ? 0.9 * done / double(totalBytes) : 0.9);
+  }
+};
+
+struct ShardCallbackCtx {
+  ExportJob *job;
+  ExportShard *shard;
+};
+
+QString zipOpenError(int code) {
+  zip_error_t ze;
+  zip_error_init_with_code(&ze, code);
+  const QString msg = QString::fromUtf8(zip_error_strerror(&ze));
+  zip_error_fini(&ze);
+  return msg;
+}
+
+void shardProgressCallback(zip_t *, double p, void *ud) {
+  auto *ctx = static_cast<ShardCallbackCtx *>(ud);
+  ctx->shard->permille.store(int(p * 1000.0));
+  ctx->job->reportCompression();
+}
+
+#if LIBZIP_VERSION_MAJOR > 1 ||                                                \
+    (LIBZIP_VERSION_MAJOR == 1 && LIBZIP_VERSION_MINOR >= 6)
+// libzip consulta este callback mientras comprime dentro de zip_close()
+int cancelCallback(zip_t *, void *ud) {
+  return static_cast<const ExportJob *>(ud)->isCancelled() ? 1 : 0;
+}
+#endif
+
+void mergeProgressCallback(zip_t *, double p, void *ud) {
+  auto *job = static_cast<ExportJob *>(ud);
+  if (job->progressFn)
+    job->progressFn(0.9 + 0.1 * p);
+}
+
+void applyCompression(zip_t *za, zip_uint64_t idx, int level) {
+  if (level <= 0)
+    zip_set_file_compression(za, idx, ZIP_CM_STORE, 0);
+  else
+    zip_set_file_compression(za, idx, ZIP_CM_DEFLATE,
+                             zip_uint32_t(std::min(level, 9)));
+}
+
+// Comprime las entradas de un shard en su zip temporal. Se ejecuta en un
+// hilo del pool; cada shard usa su propio zip_t, así que no hay estado
+// compartido con libzip entre hilos.
+void compressShard(ExportJob &job, ExportShard &shard) {
+  if (shard.entries.isEmpty())
+    return;
+  if (job.isCancelled()) {
+    shard.error = QStringLiteral("Cancelled");
+    return;
+  }
+
+  int errorCode = 0;
+  zip_t *za = zip_open(QFile::encodeName(shard.tempPath).constData(),
+                       ZIP_CREATE | ZIP_TRUNCATE, &errorCode);
+  if (!za) {
+    shard.error = zipOpenError(errorCode);
+    return;
+  }
+
+  for (const ExportEntry &e : shard.entries) {
+    zip_source_t *src =
+        zip_source_file(za, QFile::encodeName(e.absPath).constData(), 0, 0);
+    if (!src) {
+      shard.error = QString::fromUtf8(zip_strerror(za));
+      zip_discard(za);
+      return;
+    }
+    zip_int64_t idx = zip_file_add(za, e.zipName.toUtf8().constData(), src,
+                                   ZIP_FL_OVERWRITE | ZIP_FL_ENC_UTF_8);
+    if (idx < 0) {
+      shard.error = QString::fromUtf8(zip_strerror(za));
+      zip_source_free(src);
+      zip_discard(za);
+      return;
+    }
+    applyCompression(za, zip_uint64_t(idx), job.level);
+  }
+
+  ShardCallbackCtx ctx{&job, &shard};
+  zip_register_progress_callback_with_state(za, 0.01, shardProgressCallback,
+                                            nullptr, &ctx);
+#if LIBZIP_VERSION_MAJOR > 1 ||                                                \
+    (LIBZIP_VERSION_MAJOR == 1 && LIBZIP_VERSION_MINOR >= 6)
+  zip_register_cancel_callback_with_state(za, cancelCallback, nullptr, &job);
+#endif
+
+  // La compresión real ocurre aquí.
+  if (zip_close(za) < 0) {
+    shard.error = QString::fromUtf8(zip_strerror(za));
+    zip_discard(za);
+    return;
+  }
+  shard.permille.store(1000);
+  job.reportCompression();
+}
+
+zip_source_t *rawCopySource(zip_t *out, zip_t *in, zip_uint64_t idx) {
+  // Copiando la entrada completa (start 0, len -1) libzip conserva los datos
+  // comprimidos tal cual en lugar de descomprimir y volver a comprimir.
+#if LIBZIP_VERSION_MAJOR > 1 ||                                                \
+    (LIBZIP_VERSION_MAJOR == 1 && LIBZIP_VERSION_MINOR >= 10)
+  return zip_source_zip_file(out, in, idx, 0, 0, -1, nullptr);
+#else
+  return zip_source_zip(out, in, idx, 0, 0, -1);
+#endif
+}
+
+struct SnapshotEntry {
+  QString relPath;
+  QString absPath;
+  qint64 size = 0;
+  qint64 mtime = 0;
+  QString hash;
+  bool needsHash = true;
+  bool stored = false; // el objeto no existía y se copió en este snapshot
+  QString error;
+};
+
+// SHA-256 en hexadecimal tal como lo escribe hashFile. El hash forma parte
+// de la ruta del objeto, así que uno leído de un JSON se valida antes.
+bool isValidHash(const QString &hash) {
+  if (hash.size() != 64)
+    return false;
+  for (const QChar c : hash)
+    if (!((c >= QLatin1Char('0') && c <= QLatin1Char('9')) ||
+          (c >= QLatin1Char('a') && c <= QLatin1Char('f'))))
+      return false;
+  return true;
+}
+
+QString objectPath(const QString &storeDir, const QString &hash) {
+  return QDir(storeDir).filePath(QStringLiteral("objects/") + hash.left(2) +
+                                 QLatin1Char('/') + hash);
+}
+
+QString hashFile(const QString &path) {
+  QFile f(path);
+  if (!f.open(QIODevice::ReadOnly))
+    return QString();
+  QCryptographicHash h(QCryptographicHash::Sha256);
+  if (!h.addData(&f))
+    return QString();
+  return QString::fromLatin1(h.result().toHex());
+}
+
+QJsonObject readJson(const QString &path) {
+  QFile f(path);
+  if (!f.open(QIODevice::ReadOnly))
+    return QJsonObject();
+  return QJsonDocument::fromJson(f.readAll()).object();
+}
+
+bool writeJson(const QString &path, const QJsonObject &obj) {
+  QSaveFile f(path);
+  if (!f.open(QIODevice::WriteOnly))
+    return false;
+  f.write(QJsonDocument(obj).toJson(QJsonDocument::Compact));
+  return f.commit();
+}
+
+} // namespace
+
+WorldBackup::WorldBackup(QObject *parent) : QObject(parent) {}
+
+WorldBackup::~WorldBackup() {
+  if (m_cancel)
+    m_cancel->store(true);
+  m_future.waitForFinished();
+}
+
+void WorldBackup::setBusy(bool busy) {
+  if (m_busy == busy)
+    return;
+  m_busy = busy;
+  emit busyChanged();
+}
+
+void WorldBackup::setProgress(double progress) {
+  if (qFuzzyCompare(m_progress + 1.0, progress + 1.0))
+    return;
+  m_progress = progress;
+  emit progressChanged();
+}
+
+bool WorldBackup::startJob(
+    const Work &work, const std::function<void(const QString &)> &done) {
+  if (m_busy) {
+    qWarning() << "[WorldBackup] another backup operation is in progress";
+    return false;
+  }
+
+  setBusy(true);
+  setProgress(0.0);
+
+  auto *watcher = new QFutureWatcher<QString>(this);
+  connect(watcher, &QFutureWatcherBase::finished, this,
+          [this, watcher, done]() {
+            const QString error = watcher->future().result();
+            watcher->deleteLater();
+            m_cancel.reset();
+            if (error.isEmpty())
+              setProgress(1.0);
+            setBusy(false);
+            done(error);
+          });
+
+  // Los callbacks de progreso llegan desde varios hilos
+  const ProgressFn progressFn =
+      throttledProgress(this, &WorldBackup::setProgress);
+
+  auto cancelled = std::make_shared<std::atomic_bool>(false);
+  m_cancel = cancelled;
+  m_future = QtConcurrent::run([work, progressFn, cancelled]() {
+    ProcessPriority::WorkerScope priority;
+    return work(progressFn, cancelled.get());
+  });
+  watcher->setFuture(m_future);
+  return true;
+}
+
+bool WorldBackup::exportWorld(const QString &worldDir, const QString &destPath,
+                              int compressionLevel) {
+  qCDebug(lcWorlds) << "[WorldBackup] exporting" << worldDir << "->" << destPath
+                    << "level" << compressionLevel;
+
+  return startJob(
+      [worldDir, destPath, compressionLevel](
+          const ProgressFn &progressFn, const std::atomic_bool *cancelled) {
+        QString error;
+        writeMcworld(worldDir, destPath, compressionLevel, progressFn, &error,
+                     cancelled);
+        return error;
+      },
+      [this, worldDir, destPath](const QString &error) {
+        if (error.isEmpty())
+          qCDebug(lcWorlds) << "[WorldBackup] export finished:" << destPath;
+        else
+          qWarning() << "[WorldBackup] export failed:" << error;
+        emit exportFinished(worldDir, destPath, error.isEmpty(), error);
+      });
+}
+
+bool WorldBackup::backupWorlds(const QList<BackupTarget> &targets) {
+  qCDebug(lcWorlds) << "[WorldBackup] incremental backup of" << targets.size()
+                    << "world(s)";
+
+  auto ids = std::make_shared<QStringList>();
+  return startJob(
+      [targets, ids](const ProgressFn &progressFn,
+                     const std::atomic_bool *cancelled) -> QString {
+        const int count = targets.size();
+        for (int i = 0; i < count; ++i) {
+          ProgressFn scaled = [&progressFn, i, count](double p) {
+            if (progressFn)
+              progressFn((i + p) / count);
+          };
+          QString id;
+          QString error;
+          if (!writeSnapshot(targets.at(i).first, targets.at(i).second, scaled,
+                             &id, &error, cancelled))
+            return targets.at(i).first + QStringLiteral(": ") + error;
+          ids->append(id);
+        }
+        return QString();
+      },
+      [this, ids](const QString &error) {
+        if (error.isEmpty())
+          qCDebug(lcWorlds) << "[WorldBackup] backup finished:" << *ids;
+        else
+          qWarning() << "[WorldBackup] backup failed:" << error;
+        emit backupFinished(*ids, error.isEmpty(), error);
+      });
+}
+
+bool WorldBackup::restoreSnapshot(const QString &storeDir,
+                                  const QString &snapshotId,
+                                  const QString &worldDir) {
+  qCDebug(lcWorlds) << "[WorldBackup] restoring snapshot" << snapshotId
+                    << "from" << storeDir << "into" << worldDir;
+
+  return startJob(
+      [storeDir, snapshotId, worldDir](const ProgressFn &progressFn,
+                                       const std::atomic_bool *cancelled) {
+        QString error;
+        readSnapshot(storeDir, snapshotId, worldDir, progressFn, &error,
+                     cancelled);
+        return error;
+      },
+      [this, worldDir, snapshotId](const QString &error) {
+        if (error.isEmpty())
+          qCDebug(lcWorlds) << "[WorldBackup] restore finished:" << worldDir;
+        else
+          qWarning() << "[WorldBackup] restore failed:" << error;
+        emit restoreFinished(worldDir, snapshotId, error.isEmpty(), error);
+      });
+}
+
+bool WorldBackup::writeMcworld(const QString &worldDir,
+                               const QString &destPath, int compressionLevel,
+                               const std::function<void(double)> &progressFn,
+                               QString *error,
+                               const std::atomic_bool *cancelled) {
+  auto fail = [error](const QString &msg) {
+    if (error)
+      *error = msg;
+    return false;
+  };
+
+  QDir root(worldDir);
+  if (!root.exists())
+    return fail(QStringLiteral("World folder not found: ") + worldDir);
+
+  QVector<ExportEntry> entries;
+  qint64 totalBytes = 0;
+  QDirIterator it(worldDir,
+                  QDir::Files | QDir::Hidden | QDir::NoDotAndDotDot,
+                  QDirIterator::Subdirectories);
+  while (it.hasNext()) {
+    it.next();
+    const QFileInfo fi = it.fileInfo();
+    ExportEntry e;
+    e.absPath = fi.absoluteFilePath();
+    e.zipName = root.relativeFilePath(e.absPath);
+    e.size = fi.size();
+    totalBytes += e.size;
+    entries.append(e);
+  }
+  if (entries.isEmpty())
+    return fail(QStringLiteral("World folder is empty: ") + worldDir);
+
+  // Reparto voraz: el archivo más grande va al shard con menos bytes, para
+  // que los hilos terminen aproximadamente a la vez.
+  std::sort(entries.begin(), entries.end(),
+            [](const ExportEntry &a, const ExportEntry &b) {
+              return a.size > b.size;
+            });
+
+  const int shardCount =
+      qBound(1, QThread::idealThreadCount(), entries.size());
+
+  ExportJob job;
+  job.shards = std::vector<ExportShard>(size_t(shardCount));
+  job.totalBytes = totalBytes;
+  job.level = compressionLevel;
+  job.progressFn = progressFn;
+  job.cancelled = cancelled;
+
+  for (int i = 0; i < shardCount; ++i)
+    job.shards[size_t(i)].tempPath =
+        destPath + QStringLiteral(".part%1").arg(i);
+
+  for (const ExportEntry &e : entries) {
+    auto target = std::min_element(
+        job.shards.begin(), job.shards.end(),
+        [](const ExportShard &a, const ExportShard &b) {
+          return a.bytes < b.bytes;
+        });
+    target->entries.append(e);
+    target->bytes += e.size;
+  }
+
+  auto removeTemps = [&job]() {
+    for (const ExportShard &s : job.shards)
+      QFile::remove(s.tempPath);
+  };
+
+  QtConcurrent::blockingMap(job.shards, [&job](ExportShard &shard) {
+    ProcessPriority::WorkerScope priority;
+    compressShard(job, shard);
+  });
+
+  if (job.isCancelled()) {
+    removeTemps();
+    return fail(QStringLiteral("Cancelled"));
+  }
+  for (const ExportShard &s : job.shards) {
+    if (!s.error.isEmpty()) {
+      removeTemps();
+      return fail(QStringLiteral("Compression failed: ") + s.error);
+    }
+  }
+
+  // Fusión: se escribe a un temporal y se renombra al final para no dejar
+  // nunca un .mcworld a medias en el destino.
+  const QString tmpDest = destPath + QStringLiteral(".tmp");
+  int errorCode = 0;
+  zip_t *out = zip_open(QFile::encodeName(tmpDest).constData(),
+                        ZIP_CREATE | ZIP_TRUNCATE, &errorCode);
+  if (!out) {
+    removeTemps();
+    return fail(zipOpenError(errorCode));
+  }
+
+  std::vector<zip_t *> inputs;
+  auto closeInputs = [&inputs]() {
+    for (zip_t *in : inputs)
+      zip_discard(in);
+    inputs.clear();
+  };
+
+  for (const ExportShard &s : job.shards) {
+    if (s.entries.isEmpty())
+      continue;
+    if (job.isCancelled()) {
+      zip_discard(out);
+      closeInputs();
+      removeTemps();
+      return fail(QStringLiteral("Cancelled"));
+    }
+    zip_t *in = zip_open(QFile::encodeName(s.tempPath).constData(), ZIP_RDONLY,
+                         &errorCode);
+    if (!in) {
+      zip_discard(out);
+      closeInputs();
+      removeTemps();
+      return fail(zipOpenError(errorCode));
+    }
+    inputs.push_back(in);
+
+    const zip_int64_t count = zip_get_num_entries(in, 0);
+    for (zip_int64_t i = 0; i < count; ++i) {
+      const char *name = zip_get_name(in, zip_uint64_t(i), 0);
+      zip_source_t *src = name ? rawCopySource(out, in, zip_uint64_t(i))
+                               : nullptr;
+      if (!src || zip_file_add(out, name, src, ZIP_FL_ENC_UTF_8) < 0) {
+        const QString msg = QString::fromUtf8(zip_strerror(out));
+        if (src)
+          zip_source_free(src);
+        zip_discard(out);
+        closeInputs();
+        removeTemps();
+        return fail(QStringLiteral("Merge failed: ") + msg);
+      }
+    }
+  }
+
+  zip_register_progress_callback_with_state(out, 0.01, mergeProgressCallback,
+                                            nullptr, &job);
+#if LIBZIP_VERSION_MAJOR > 1 ||                                                \
+    (LIBZIP_VERSION_MAJOR == 1 && LIBZIP_VERSION_MINOR >= 6)
+  zip_register_cancel_callback_with_state(out, cancelCallback, nullptr, &job);
+#endif
+  if (zip_close(out) < 0) {
+    const QString msg = QString::fromUtf8(zip_strerror(out));
+    zip_discard(out);
+    closeInputs();
+    removeTemps();
+    QFile::remove(tmpDest);
+    return fail(QStringLiteral("Failed to write archive: ") + msg);
+  }
+  closeInputs();
+  removeTemps();
+
+  QFile::remove(destPath);
+  if (!QFile::rename(tmpDest, destPath)) {
+    QFile::remove(tmpDest);
+    return fail(QStringLiteral("Failed to move archive to ") + destPath);
+  }
+  return true;
+}
+
+bool WorldBackup::writeSnapshot(const QString &worldDir,
+                                const QString &storeDir,
+                                const ProgressFn &progressFn,
+                                QString *snapshotId, QString *error,
+                                const std::atomic_bool *cancelled) {
+  auto fail = [error](const QString &msg) {
+    if (error)
+      *error = msg;
+    return false;
+  };
+
+  QDir root(worldDir);
+  if (!root.exists())
+    return fail(QStringLiteral("World folder not found: ") + worldDir);
+  if (!QDir().mkpath(QDir(storeDir).filePath("objects")) ||
+      !QDir().mkpath(QDir(storeDir).filePath("snapshots")))
+    return fail(QStringLiteral("Cannot create backup store: ") + storeDir);
+
+  // Estado del último snapshot: si tamaño y fecha coinciden se reutiliza el
+  // hash sin volver a leer el archivo (la mayoría de .ldb no cambian).
+  const QString manifestPath = QDir(storeDir).filePath("manifest.json");
+  const QJsonObject previous =
+      readJson(manifestPath).value("files").toObject();
+
+  std::vector<SnapshotEntry> entries;
+  QDirIterator it(worldDir,
+                  QDir::Files | QDir::Hidden | QDir::NoDotAndDotDot,
+                  QDirIterator::Subdirectories);
+  while (it.hasNext()) {
+    it.next();
+    const QFileInfo fi = it.fileInfo();
+    SnapshotEntry e;
+    e.absPath = fi.absoluteFilePath();
+    e.relPath = root.relativeFilePath(e.absPath);
+    e.size = fi.size();
+    e.mtime = fi.lastModified().toMSecsSinceEpoch();
+
+    const QJsonObject known = previous.value(e.relPath).toObject();
+    if (!known.isEmpty() &&
+        qint64(known.value("size").toDouble()) == e.size &&
+        qint64(known.value("mtime").toDouble()) == e.mtime) {
+      e.hash = known.value("hash").toString();
+      e.needsHash = !isValidHash(e.hash);
+    }
+    entries.push_back(e);
+  }
+
+  qint64 workBytes = 0;
+  for (const SnapshotEntry &e : entries)
+    if (e.needsHash)
+      workBytes += e.size;
+
+  std::atomic<qint64> doneBytes{0};
+  QtConcurrent::blockingMap(entries, [&](SnapshotEntry &e) {
+    ProcessPriority::WorkerScope priority;
+    if (cancelled && cancelled->load()) {
+      e.error = QStringLiteral("Cancelled");
+      return;
+    }
+    if (e.needsHash) {
+      e.hash = hashFile(e.absPath);
+      if (e.hash.isEmpty()) {
+        e.error = QStringLiteral("Cannot read ") + e.relPath;
+        return;
+      }
+    }
+
+    const qint64 scannedSize = e.size;
+    QString object = objectPath(storeDir, e.hash);
+    if (!QFile::exists(object)) {
+      QDir().mkpath(QFileInfo(object).absolutePath());
+      // Nombre temporal único por entrada: dos archivos idénticos pueden
+      // llegar aquí a la vez con el mismo hash.
+      const QString tmp =
+          object + QStringLiteral(".tmp-%1").arg(quintptr(&e), 0, 16);
+      QFile::remove(tmp);
+      if (!QFile::copy(e.absPath, tmp)) {
+        QFile::remove(tmp);
+        e.error = QStringLiteral("Cannot store ") + e.relPath;
+        return;
+      }
+      // El archivo puede haber cambiado entre el hash y la copia: el objeto
+      // se guarda con el hash de lo que realmente se copió
+      const QString copied = hashFile(tmp);
+      if (copied.isEmpty()) {
+        QFile::remove(tmp);
+        e.error = QStringLiteral("Cannot read ") + e.relPath;
+        return;
+      }
+      if (copied != e.hash) {
+        e.hash = copied;
+        e.size = QFileInfo(tmp).size();
+        object = objectPath(storeDir, e.hash);
+        QDir().mkpath(QFileInfo(object).absolutePath());
+      }
+      if (!QFile::exists(object) && !QFile::rename(tmp, object) &&
+          !QFile::exists(object)) {
+        QFile::remove(tmp);
+        e.error = QStringLiteral("Cannot store ") + e.relPath;
+        return;
+      }
+      QFile::remove(tmp);
+      e.stored = true;
+    }
+
+    if (e.needsHash && progressFn) {
+      const qint64 done = doneBytes.fetch_add(scannedSize) + scannedSize;
+      progressFn(workBytes > 0 ? double(done) / double(workBytes) : 1.0);
+    }
+  });
+
+  QJsonObject manifestFiles;
+  QJsonArray snapshotFiles;
+  qint64 totalBytes = 0;
+  qint64 newBytes = 0;
+  int newFiles = 0;
+  for (const SnapshotEntry &e : entries) {
+    if (!e.error.isEmpty())
+      return fail(e.error);
+
+    QJsonObject file;
+    file.insert("hash", e.hash);
+    file.insert("size", double(e.size));
+    file.insert("mtime", double(e.mtime));
+    manifestFiles.insert(e.relPath, file);
+
+    file.insert("path", e.relPath);
+    snapshotFiles.append(file);
+
+    totalBytes += e.size;
+    if (e.stored) {
+      newBytes += e.size;
+      ++newFiles;
+    }
+  }
+
+  const QDateTime now = QDateTime::currentDateTimeUtc();
+  const QString id = now.toString("yyyyMMdd-HHmmss-zzz");
+
+  QJsonObject snapshot;
+  snapshot.insert("id", id);
+  snapshot.insert("created", now.toString(Qt::ISODateWithMs));
+  snapshot.insert("world", worldDir);
+  snapshot.insert("totalBytes", double(totalBytes));
+  snapshot.insert("newBytes", double(newBytes));
+  snapshot.insert("newFiles", newFiles);
+  snapshot.insert("files", snapshotFiles);
+
+  if (!writeJson(QDir(storeDir).filePath("snapshots/" + id + ".json"),
+                 snapshot))
+    return fail(QStringLiteral("Cannot write snapshot ") + id);
+
+  QJsonObject manifest;
+  manifest.insert("lastSnapshot", id);
+  manifest.insert("files", manifestFiles);
+  if (!writeJson(manifestPath, manifest))
+    return fail(QStringLiteral("Cannot write manifest in ") + storeDir);
+
+  qCDebug(lcWorlds) << "[WorldBackup] snapshot" << id << "of" << worldDir << ":"
+                    << entries.size() << "files," << newFiles << "new ("
+                    << newBytes << "bytes)";
+  if (snapshotId)
+    *snapshotId = id;
+  return true;
+}
+
+bool WorldBackup::readSnapshot(const QString &storeDir,
+                               const QString &snapshotId,
+                               const QString &worldDir,
+                               const ProgressFn &progressFn, QString *error,
+                               const std::atomic_bool *cancelled) {
+  auto fail = [error](const QString &msg) {
+    if (error)
+      *error = msg;
+    return false;
+  };
+
+  const QJsonObject snapshot =
+      readJson(QDir(storeDir).filePath("snapshots/" + snapshotId + ".json"));
+  if (snapshot.isEmpty())
+    return fail(QStringLiteral("Snapshot not found: ") + snapshotId);
+
+  std::vector<SnapshotEntry> entries;
+  qint64 totalBytes = 0;
+  const QJsonArray files = snapshot.value("files").toArray();
+  for (const QJsonValue &v : files) {
+    const QJsonObject o = v.toObject();
+    SnapshotEntry e;
+    e.relPath = o.value("path").toString();
+    e.hash = o.value("hash").toString();
+    e.size = qint64(o.value("size").toDouble());
+    e.mtime = qint64(o.value("mtime").toDouble());
+    // Nunca escribir fuera del mundo aunque el JSON esté manipulado.
+    if (e.relPath.isEmpty() || !isValidHash(e.hash) ||
+        QDir::isAbsolutePath(e.relPath) ||
+        QDir::cleanPath(e.relPath).startsWith(QLatin1String("..")))
+      return fail(QStringLiteral("Invalid entry in snapshot ") + snapshotId);
+    totalBytes += e.size;
+    entries.push_back(e);
+  }
+
+  // Se reconstruye al lado del mundo y se intercambia al final, de modo que
+  // un fallo a mitad no deja el mundo original destruido.
+  const QString staging = QDir::cleanPath(worldDir) + ".restoring";
+  QDir(staging).removeRecursively();
+  if (!QDir().mkpath(staging))
+    return fail(QStringLiteral("Cannot create ") + staging);
+
+  std::atomic<qint64> doneBytes{0};
+  QtConcurrent::blockingMap(entries, [&](SnapshotEntry &e) {
+    ProcessPriority::WorkerScope priority;
+    if (cancelled && cancelled->load()) {
+      e.error = QStringLiteral("Cancelled");
+      return;
+    }
+    const QString dest = QDir(staging).filePath(e.relPath);
+    QDir().mkpath(QFileInfo(dest).absolutePath());
+    if (!QFile::copy(objectPath(storeDir, e.hash), dest)) {
+      e.error = QStringLiteral("Missing object for ") + e.relPath;
+      return;
+    }
+    // Conservar la fecha original mantiene válido el manifiesto incremental.
+    QFile out(dest);
+    if (out.open(QIODevice::ReadWrite))
+      out.setFileTime(QDateTime::fromMSecsSinceEpoch(e.mtime),
+                      QFileDevice::FileModificationTime);
+    if (progressFn) {
+      const qint64 done = doneBytes.fetch_add(e.size) + e.size;
+      progressFn(totalBytes > 0 ? double(done) / double(totalBytes) : 1.0);
+    }
+  });
+
+  for (const SnapshotEntry &e : entries) {
+    if (!e.error.isEmpty()) {
+      QDir(staging).removeRecursively();
+      return fail(e.error);
+    }
+  }
+
+  const QString old = QDir::cleanPath(worldDir) + ".old";
+  QDir(old).removeRecursively();
+  if (QDir(worldDir).exists() && !QDir().rename(worldDir, old)) {
+    QDir(staging).removeRecursively();
+    return fail(QStringLiteral("Cannot replace ") + worldDir);
+  }
+  if (!QDir().rename(staging, worldDir)) {
+    QDir().rename(old, worldDir);
+    QDir(staging).removeRecursively();
+    return fail(QStringLiteral("Cannot move restored world into ") + worldDir);
+  }
+  QDir(old).removeRecursively();
+  return true;
+}
+
+QVariantList WorldBackup::listSnapshots(const QString &storeDir) {
+  QVariantList list;
+  QDir dir(QDir(storeDir).filePath("snapshots"));
+  const QStringList files =
+      dir.entryList(QStringList() << "*.json", QDir::Files, QDir::Name);
+  for (auto it = files.crbegin(); it != files.crend(); ++it) {
+    const QJsonObject o = readJson(dir.filePath(*it));
+    if (o.isEmpty())
+      continue;
+    QVariantMap m;
+    m.insert("id", o.value("id").toString());
+    m.insert("created", o.value("created").toString());
+    m.insert("fileCount", o.value("files").toArray().size());
+    m.insert("totalBytes", o.value("totalBytes").toDouble());
+    m.insert("newBytes", o.value("newBytes").toDouble());
+    m.insert("newFiles", o.value("newFiles").toInt());
+    list.append(m);
+  }
+  return list;
+}